@@ -0,0 +1,133 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <cstddef>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "xframe/xaxis.hpp"
+
+namespace xf
+{
+    using int_axis = xaxis<int, std::size_t>;
+
+    // Labels are in decreasing order so that the axis is not sorted;
+    // the second axis overlaps the upper half of the first one.
+    inline std::vector<int> make_unsorted_labels(std::size_t size, int offset)
+    {
+        std::vector<int> res(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            res[i] = offset + static_cast<int>(size - i);
+        }
+        return res;
+    }
+
+    void xaxis_merge_unsorted(benchmark::State& state)
+    {
+        std::size_t size = static_cast<std::size_t>(state.range(0));
+        int_axis a(make_unsorted_labels(size, 0));
+        int_axis b(make_unsorted_labels(size, static_cast<int>(size / 2)));
+        for (auto _ : state)
+        {
+            int_axis res = a;
+            benchmark::DoNotOptimize(res.merge(b));
+        }
+        state.SetComplexityN(state.range(0));
+    }
+    BENCHMARK(xaxis_merge_unsorted)->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->Complexity(benchmark::oN);
+
+    void xaxis_intersect_unsorted(benchmark::State& state)
+    {
+        std::size_t size = static_cast<std::size_t>(state.range(0));
+        int_axis a(make_unsorted_labels(size, 0));
+        int_axis b(make_unsorted_labels(size, static_cast<int>(size / 2)));
+        for (auto _ : state)
+        {
+            int_axis res = a;
+            benchmark::DoNotOptimize(res.intersect(b));
+        }
+        state.SetComplexityN(state.range(0));
+    }
+    BENCHMARK(xaxis_intersect_unsorted)->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->Complexity(benchmark::oN);
+
+    // Three sorted axes with interleaved labels.
+    inline std::vector<int> make_sorted_labels(std::size_t size, int offset)
+    {
+        std::vector<int> res(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            res[i] = offset + 3 * static_cast<int>(i);
+        }
+        return res;
+    }
+
+    void xaxis_merge_sorted(benchmark::State& state)
+    {
+        std::size_t size = static_cast<std::size_t>(state.range(0));
+        int_axis a(make_sorted_labels(size, 0));
+        int_axis b(make_sorted_labels(size, 1));
+        int_axis c(make_sorted_labels(size, 2));
+        for (auto _ : state)
+        {
+            int_axis res = a;
+            benchmark::DoNotOptimize(res.merge(b, c));
+        }
+        state.SetComplexityN(state.range(0));
+    }
+    BENCHMARK(xaxis_merge_sorted)->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->Complexity(benchmark::oN);
+
+    void xaxis_intersect_sorted(benchmark::State& state)
+    {
+        std::size_t size = static_cast<std::size_t>(state.range(0));
+        int_axis a(make_sorted_labels(size, 0));
+        int_axis b(make_sorted_labels(size, 0));
+        int_axis c(make_sorted_labels(size / 2, 0));
+        for (auto _ : state)
+        {
+            int_axis res = a;
+            benchmark::DoNotOptimize(res.intersect(b, c));
+        }
+        state.SetComplexityN(state.range(0));
+    }
+    BENCHMARK(xaxis_intersect_sorted)->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->Complexity(benchmark::oN);
+
+    template <class MT>
+    void xaxis_build_sorted(benchmark::State& state)
+    {
+        std::size_t size = static_cast<std::size_t>(state.range(0));
+        std::vector<int> labels = make_sorted_labels(size, 0);
+        for (auto _ : state)
+        {
+            xaxis<int, std::size_t, MT> a(labels);
+            benchmark::DoNotOptimize(a.size());
+        }
+        state.SetComplexityN(state.range(0));
+    }
+    BENCHMARK_TEMPLATE(xaxis_build_sorted, hash_map_tag)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->Complexity(benchmark::oN);
+    BENCHMARK_TEMPLATE(xaxis_build_sorted, sorted_tag)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->Complexity(benchmark::oN);
+
+    template <class MT>
+    void xaxis_lookup_sorted(benchmark::State& state)
+    {
+        std::size_t size = static_cast<std::size_t>(state.range(0));
+        xaxis<int, std::size_t, MT> a(make_sorted_labels(size, 0));
+        int key = 0;
+        int last = 3 * static_cast<int>(size);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(a.contains(key));
+            key = key + 7 < last ? key + 7 : 0;
+        }
+    }
+    BENCHMARK_TEMPLATE(xaxis_lookup_sorted, hash_map_tag)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+    BENCHMARK_TEMPLATE(xaxis_lookup_sorted, sorted_tag)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+}
@@ -15,6 +15,9 @@
 #include <iterator>
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -31,6 +34,9 @@ namespace xf
     template <class L, class T, class MT>
     class xaxis_iterator;
 
+    template <class L, class T>
+    class xaxis_sorted_iterator;
+
     template <class L, class T>
     class xaxis_default;
 
@@ -40,6 +46,39 @@ namespace xf
 
     struct map_tag {};
     struct hash_map_tag {};
+    struct sorted_tag {};
+
+    /**
+     * @class xsorted_index
+     * @brief Index of an axis with sorted labels.
+     *
+     * The xsorted_index does not hold any label - position pair. An
+     * axis using the \c sorted_tag finds positions with a binary search
+     * in its sorted list of labels, so that it does not store anything
+     * but this list.
+     *
+     * @tparam K the type of labels.
+     * @tparam T the integer type used to represent positions.
+     */
+    template <class K, class T>
+    class xsorted_index
+    {
+    public:
+
+        using key_type = K;
+        using mapped_type = T;
+        using value_type = std::pair<K, T>;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using size_type = std::size_t;
+
+        bool empty() const noexcept;
+        void clear() noexcept;
+    };
 
     template <class K, class T, class MT>
     struct map_container;
@@ -56,9 +95,62 @@ namespace xf
         using type = std::unordered_map<K, T>;
     };
 
+    template <class K, class T>
+    struct map_container<K, T, sorted_tag>
+    {
+        using type = xsorted_index<K, T>;
+    };
+
     template <class K, class T, class MT>
     using map_container_t = typename map_container<K, T, MT>::type;
 
+    namespace detail
+    {
+        // Builds the key used to look a label up from a value of another
+        // type. Label types that must not register the keys they are looked
+        // up with, such as interned strings, provide a static lookup function.
+
+        template <class K, class S>
+        inline auto lookup_key_impl(const S& key, int) -> decltype(K::lookup(key))
+        {
+            return K::lookup(key);
+        }
+
+        template <class K, class S>
+        inline K lookup_key_impl(const S& key, long)
+        {
+            return K(key);
+        }
+
+        template <class K, class S>
+        inline K lookup_key(const S& key)
+        {
+            return lookup_key_impl<K>(key, 0);
+        }
+
+        template <class S, class K>
+        using enable_lookup_key_t = std::enable_if_t<!std::is_same<std::decay_t<S>, K>::value &&
+                                                     std::is_constructible<K, const S&>::value>;
+
+        // Type of the keys that selectors hold for labels of type K; such
+        // label types provide it as lookup_type.
+
+        template <class K, class = void>
+        struct lookup_type
+        {
+            using type = K;
+        };
+
+        template <class K>
+        struct lookup_type<K, xt::void_t<typename K::lookup_type>>
+        {
+            using type = typename K::lookup_type;
+        };
+
+        template <class K>
+        using lookup_type_t = typename lookup_type<K>::type;
+    }
+
     /*********
      * xaxis *
      *********/
@@ -75,8 +167,14 @@ namespace xf
      * @tparam T the integer type used to represent positions. Default value is
      *           \c std::size_t.
      * @tparam MT the tag used for choosing the map type which holds the label-
-     *            position pairs. Possible values are \c map_tag and \c hash_map_tag.
-     *            Default value is \c hash_map_tag.
+     *            position pairs. Possible values are \c map_tag, \c hash_map_tag
+     *            and \c sorted_tag. Default value is \c hash_map_tag. With
+     *            \c sorted_tag, the labels must be sorted; no map is built and
+     *            positions are found by binary search.
+     *
+     * Like the labels, the map is shared between the copies of an axis until
+     * one of them is modified. Merging or intersecting axes sharing their
+     * labels does not compare them.
      */
     template <class L, class T = std::size_t, class MT = hash_map_tag>
     class xaxis : public xaxis_base<xaxis<L, T, MT>>
@@ -117,6 +215,11 @@ namespace xf
         bool contains(const key_type& key) const;
         mapped_type operator[](const key_type& key) const;
 
+        template <class S, class = detail::enable_lookup_key_t<S, L>>
+        bool contains(const S& key) const;
+        template <class S, class = detail::enable_lookup_key_t<S, L>>
+        mapped_type operator[](const S& key) const;
+
         template <class F>
         self_type filter(const F& f) const noexcept;
 
@@ -125,6 +228,12 @@ namespace xf
 
         const_iterator find(const key_type& key) const;
 
+        template <class S, class = detail::enable_lookup_key_t<S, L>>
+        const_iterator find(const S& key) const;
+
+        size_type lower_bound_index(const key_type& key) const;
+        size_type upper_bound_index(const key_type& key) const;
+
         const_iterator cbegin() const noexcept;
         const_iterator cend() const noexcept;
 
@@ -154,11 +263,42 @@ namespace xf
 
         typename map_type::const_iterator find_index(const key_type& key) const;
 
+        size_type find_position(const key_type& key) const;
+
+        template <class Tag>
+        size_type find_position_impl(const key_type& key, Tag) const;
+        size_type find_position_impl(const key_type& key, sorted_tag) const;
+
+        template <class Tag>
+        void populate_index_impl(Tag);
+        void populate_index_impl(sorted_tag);
+
+        map_type& mutable_index();
+
+        template <class... Args>
+        bool shares_labels(const Args&... axes) const noexcept;
+
         template <class... Args>
         bool merge_impl(const Args&... axes);
 
+        template <class Tag, class... Args>
+        bool merge_not_sorted(Tag, const Args&... axes);
+
+        template <class... Args>
+        bool merge_not_sorted(sorted_tag, const Args&... axes);
+
+        template <class Tag, class... Args>
+        bool intersect_not_sorted(Tag, const Args&... axes);
+
+        template <class... Args>
+        bool intersect_not_sorted(sorted_tag, const Args&... axes);
+
+        void sort_labels();
+
         template <class Arg1, class... Args>
         bool merge_empty(const Arg1& a, const Args&... axes);
+        template <class... Args>
+        bool merge_empty(const self_type& a, const Args&... axes);
         bool merge_empty();
 
         bool init_is_sorted() const noexcept;
@@ -169,7 +309,7 @@ namespace xf
         template <class Arg>
         bool all_sorted(const Arg& a) const noexcept;
 
-        map_type m_index;
+        std::shared_ptr<map_type> p_index;
         bool m_is_sorted;
 
         friend class xaxis_iterator<L, T, MT>;
@@ -207,6 +347,14 @@ namespace xf
         using iterator = xaxis_iterator<L, T, MT>;
     };
 
+    template <class L, class T>
+    struct xaxis_inner_types<xaxis<L, T, sorted_tag>>
+    {
+        using key_type = L;
+        using mapped_type = T;
+        using iterator = xaxis_sorted_iterator<L, T>;
+    };
+
     /******************
      * xaxis_iterator *
      ******************/
@@ -263,6 +411,479 @@ namespace xf
     template <class L, class T, class MT>
     bool operator<(const xaxis_iterator<L, T, MT>& lhs, const xaxis_iterator<L, T, MT>& rhs) noexcept;
 
+    /*************************
+     * xaxis_sorted_iterator *
+     *************************/
+
+    template <class L, class T>
+    class xaxis_sorted_iterator : public xtl::xrandom_access_iterator_base<xaxis_sorted_iterator<L, T>,
+                                                                           typename xaxis<L, T, sorted_tag>::value_type,
+                                                                           typename xaxis<L, T, sorted_tag>::difference_type,
+                                                                           typename xaxis<L, T, sorted_tag>::const_pointer,
+                                                                           typename xaxis<L, T, sorted_tag>::const_reference>
+    {
+
+    public:
+
+        using self_type = xaxis_sorted_iterator<L, T>;
+        using container_type = xaxis<L, T, sorted_tag>;
+        using label_list = typename container_type::label_list;
+        using label_iterator = typename label_list::const_iterator;
+        using mapped_type = typename container_type::mapped_type;
+        using value_type = typename container_type::value_type;
+        using reference = typename container_type::const_reference;
+        using pointer = typename container_type::const_pointer;
+        using difference_type = typename container_type::difference_type;
+        using iterator_category = std::random_access_iterator_tag;
+
+        xaxis_sorted_iterator() = default;
+        xaxis_sorted_iterator(const container_type* c, label_iterator it);
+
+        self_type& operator++();
+        self_type& operator--();
+
+        self_type& operator+=(difference_type n);
+        self_type& operator-=(difference_type n);
+
+        difference_type operator-(const self_type& rhs) const;
+
+        reference operator*() const;
+        pointer operator->() const;
+
+        bool equal(const self_type& rhs) const noexcept;
+        bool less_than(const self_type& rhs) const noexcept;
+
+    private:
+
+        label_iterator m_first;
+        label_iterator m_it;
+        mutable value_type m_value;
+    };
+
+    template <class L, class T>
+    typename xaxis_sorted_iterator<L, T>::difference_type operator-(const xaxis_sorted_iterator<L, T>& lhs, const xaxis_sorted_iterator<L, T>& rhs);
+
+    template <class L, class T>
+    bool operator==(const xaxis_sorted_iterator<L, T>& lhs, const xaxis_sorted_iterator<L, T>& rhs) noexcept;
+
+    template <class L, class T>
+    bool operator<(const xaxis_sorted_iterator<L, T>& lhs, const xaxis_sorted_iterator<L, T>& rhs) noexcept;
+
+    /********************************
+     * xsorted_index implementation *
+     ********************************/
+
+    template <class K, class T>
+    inline bool xsorted_index<K, T>::empty() const noexcept
+    {
+        return true;
+    }
+
+    template <class K, class T>
+    inline void xsorted_index<K, T>::clear() noexcept
+    {
+    }
+
+    namespace detail
+    {
+        /*********************
+         * xaxis_label_range *
+         *********************/
+
+        // Random access range over labels that are not owned: either a
+        // contiguous list of labels, or the integral labels [0, size) of a
+        // default axis, which are computed on the fly.
+
+        template <class L>
+        class xaxis_label_iterator : public xtl::xrandom_access_iterator_base<xaxis_label_iterator<L>,
+                                                                             L, std::ptrdiff_t, const L*, L>
+        {
+        public:
+
+            using self_type = xaxis_label_iterator<L>;
+            using value_type = L;
+            using reference = L;
+            using pointer = const L*;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::random_access_iterator_tag;
+
+            xaxis_label_iterator() = default;
+            xaxis_label_iterator(const L* data, difference_type index) noexcept;
+
+            self_type& operator++();
+            self_type& operator--();
+
+            self_type& operator+=(difference_type n);
+            self_type& operator-=(difference_type n);
+
+            difference_type operator-(const self_type& rhs) const;
+
+            reference operator*() const;
+
+            bool equal(const self_type& rhs) const noexcept;
+            bool less_than(const self_type& rhs) const noexcept;
+
+        private:
+
+            const L* p_data = nullptr;
+            difference_type m_index = 0;
+        };
+
+        template <class L>
+        typename xaxis_label_iterator<L>::difference_type operator-(const xaxis_label_iterator<L>& lhs, const xaxis_label_iterator<L>& rhs);
+
+        template <class L>
+        bool operator==(const xaxis_label_iterator<L>& lhs, const xaxis_label_iterator<L>& rhs) noexcept;
+
+        template <class L>
+        bool operator<(const xaxis_label_iterator<L>& lhs, const xaxis_label_iterator<L>& rhs) noexcept;
+
+        template <class L>
+        class xaxis_label_range
+        {
+        public:
+
+            using value_type = L;
+            using size_type = std::size_t;
+            using const_iterator = xaxis_label_iterator<L>;
+            using iterator = const_iterator;
+            using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+            using reverse_iterator = const_reverse_iterator;
+
+            explicit xaxis_label_range(const std::vector<L>& labels) noexcept;
+            explicit xaxis_label_range(size_type size) noexcept;
+
+            const L* data() const noexcept;
+            size_type size() const noexcept;
+            bool empty() const noexcept;
+
+            value_type operator[](size_type i) const;
+
+            const_iterator begin() const noexcept;
+            const_iterator end() const noexcept;
+
+            const_iterator cbegin() const noexcept;
+            const_iterator cend() const noexcept;
+
+            const_reverse_iterator rbegin() const noexcept;
+            const_reverse_iterator rend() const noexcept;
+
+        private:
+
+            const L* p_data;
+            size_type m_size;
+        };
+
+        template <class L>
+        inline std::enable_if_t<std::is_integral<L>::value, L> counted_label(std::ptrdiff_t i) noexcept
+        {
+            return static_cast<L>(i);
+        }
+
+        // Only default axes, whose labels are integral, are counted.
+        template <class L>
+        inline std::enable_if_t<!std::is_integral<L>::value, L> counted_label(std::ptrdiff_t) noexcept
+        {
+            return L();
+        }
+
+        template <class L>
+        inline xaxis_label_iterator<L>::xaxis_label_iterator(const L* data, difference_type index) noexcept
+            : p_data(data), m_index(index)
+        {
+        }
+
+        template <class L>
+        inline auto xaxis_label_iterator<L>::operator++() -> self_type&
+        {
+            ++m_index;
+            return *this;
+        }
+
+        template <class L>
+        inline auto xaxis_label_iterator<L>::operator--() -> self_type&
+        {
+            --m_index;
+            return *this;
+        }
+
+        template <class L>
+        inline auto xaxis_label_iterator<L>::operator+=(difference_type n) -> self_type&
+        {
+            m_index += n;
+            return *this;
+        }
+
+        template <class L>
+        inline auto xaxis_label_iterator<L>::operator-=(difference_type n) -> self_type&
+        {
+            m_index -= n;
+            return *this;
+        }
+
+        template <class L>
+        inline auto xaxis_label_iterator<L>::operator-(const self_type& rhs) const -> difference_type
+        {
+            return m_index - rhs.m_index;
+        }
+
+        template <class L>
+        inline auto xaxis_label_iterator<L>::operator*() const -> reference
+        {
+            return p_data != nullptr ? p_data[m_index] : counted_label<L>(m_index);
+        }
+
+        template <class L>
+        inline bool xaxis_label_iterator<L>::equal(const self_type& rhs) const noexcept
+        {
+            return m_index == rhs.m_index;
+        }
+
+        template <class L>
+        inline bool xaxis_label_iterator<L>::less_than(const self_type& rhs) const noexcept
+        {
+            return m_index < rhs.m_index;
+        }
+
+        template <class L>
+        inline typename xaxis_label_iterator<L>::difference_type operator-(const xaxis_label_iterator<L>& lhs, const xaxis_label_iterator<L>& rhs)
+        {
+            return lhs.operator-(rhs);
+        }
+
+        template <class L>
+        inline bool operator==(const xaxis_label_iterator<L>& lhs, const xaxis_label_iterator<L>& rhs) noexcept
+        {
+            return lhs.equal(rhs);
+        }
+
+        template <class L>
+        inline bool operator<(const xaxis_label_iterator<L>& lhs, const xaxis_label_iterator<L>& rhs) noexcept
+        {
+            return lhs.less_than(rhs);
+        }
+
+        template <class L>
+        inline xaxis_label_range<L>::xaxis_label_range(const std::vector<L>& labels) noexcept
+            : p_data(labels.data()), m_size(labels.size())
+        {
+        }
+
+        template <class L>
+        inline xaxis_label_range<L>::xaxis_label_range(size_type size) noexcept
+            : p_data(nullptr), m_size(size)
+        {
+        }
+
+        template <class L>
+        inline const L* xaxis_label_range<L>::data() const noexcept
+        {
+            return p_data;
+        }
+
+        template <class L>
+        inline auto xaxis_label_range<L>::size() const noexcept -> size_type
+        {
+            return m_size;
+        }
+
+        template <class L>
+        inline bool xaxis_label_range<L>::empty() const noexcept
+        {
+            return m_size == size_type(0);
+        }
+
+        template <class L>
+        inline auto xaxis_label_range<L>::operator[](size_type i) const -> value_type
+        {
+            return p_data != nullptr ? p_data[i] : counted_label<L>(static_cast<std::ptrdiff_t>(i));
+        }
+
+        template <class L>
+        inline auto xaxis_label_range<L>::begin() const noexcept -> const_iterator
+        {
+            return cbegin();
+        }
+
+        template <class L>
+        inline auto xaxis_label_range<L>::end() const noexcept -> const_iterator
+        {
+            return cend();
+        }
+
+        template <class L>
+        inline auto xaxis_label_range<L>::cbegin() const noexcept -> const_iterator
+        {
+            return const_iterator(p_data, 0);
+        }
+
+        template <class L>
+        inline auto xaxis_label_range<L>::cend() const noexcept -> const_iterator
+        {
+            return const_iterator(p_data, static_cast<std::ptrdiff_t>(m_size));
+        }
+
+        template <class L>
+        inline auto xaxis_label_range<L>::rbegin() const noexcept -> const_reverse_iterator
+        {
+            return const_reverse_iterator(cend());
+        }
+
+        template <class L>
+        inline auto xaxis_label_range<L>::rend() const noexcept -> const_reverse_iterator
+        {
+            return const_reverse_iterator(cbegin());
+        }
+
+        // Axes built as copies of each other share their labels; labels
+        // computed on the fly are never shared.
+
+        template <class LL>
+        inline bool shares_label_list(const LL& lhs, const LL& rhs) noexcept
+        {
+            return &lhs == &rhs;
+        }
+
+        template <class LL, class L>
+        inline bool shares_label_list(const LL& lhs, const xaxis_label_range<L>& rhs) noexcept
+        {
+            return rhs.data() != nullptr && rhs.data() == lhs.data() && rhs.size() == lhs.size();
+        }
+
+        // Branch-free lower bound: the loop runs exactly log2(n) times
+        // and the comparison compiles to a conditional move for
+        // arithmetic labels.
+        template <class It, class K>
+        inline It branchless_lower_bound(It first, It last, const K& key)
+        {
+            auto n = std::distance(first, last);
+            if (n == 0)
+            {
+                return first;
+            }
+            while (n > 1)
+            {
+                auto half = n / 2;
+                first = (first[half] < key) ? first + half : first;
+                n -= half;
+            }
+            return first + static_cast<decltype(n)>(*first < key);
+        }
+
+        template <class It, class K>
+        inline It branchless_upper_bound(It first, It last, const K& key)
+        {
+            auto n = std::distance(first, last);
+            if (n == 0)
+            {
+                return first;
+            }
+            while (n > 1)
+            {
+                auto half = n / 2;
+                first = !(key < first[half]) ? first + half : first;
+                n -= half;
+            }
+            return first + static_cast<decltype(n)>(!(key < *first));
+        }
+
+        // Sorted sequence of the labels of an axis. If the axis
+        // is not sorted, its labels are copied, sorted and made
+        // unique; otherwise they are referenced.
+        template <class LL>
+        class xsorted_labels
+        {
+        public:
+
+            using value_type = typename LL::value_type;
+            using range_type = xaxis_label_range<value_type>;
+            using const_iterator = typename range_type::const_iterator;
+
+            template <class A>
+            explicit xsorted_labels(const A& axis);
+
+            xsorted_labels(const xsorted_labels&) = delete;
+            xsorted_labels& operator=(const xsorted_labels&) = delete;
+
+            const_iterator begin() const noexcept;
+            const_iterator end() const noexcept;
+
+            const_iterator cbegin() const noexcept;
+            const_iterator cend() const noexcept;
+
+        private:
+
+            void set_labels(const LL& labels) noexcept;
+            void set_labels(LL&& labels);
+            void set_labels(const range_type& labels) noexcept;
+
+            LL m_copy;
+            range_type m_labels;
+        };
+
+        template <class LL>
+        template <class A>
+        inline xsorted_labels<LL>::xsorted_labels(const A& axis)
+            : m_copy(), m_labels(std::size_t(0))
+        {
+            set_labels(axis.labels());
+            if (!axis.is_sorted())
+            {
+                if (m_copy.empty())
+                {
+                    m_copy.assign(m_labels.begin(), m_labels.end());
+                }
+                std::sort(m_copy.begin(), m_copy.end());
+                m_copy.erase(std::unique(m_copy.begin(), m_copy.end()), m_copy.end());
+                m_labels = range_type(m_copy);
+            }
+        }
+
+        template <class LL>
+        inline void xsorted_labels<LL>::set_labels(const LL& labels) noexcept
+        {
+            m_labels = range_type(labels);
+        }
+
+        // Labels built on the fly by the axis are kept alive.
+        template <class LL>
+        inline void xsorted_labels<LL>::set_labels(LL&& labels)
+        {
+            m_copy = std::move(labels);
+            m_labels = range_type(m_copy);
+        }
+
+        template <class LL>
+        inline void xsorted_labels<LL>::set_labels(const range_type& labels) noexcept
+        {
+            m_labels = labels;
+        }
+
+        template <class LL>
+        inline auto xsorted_labels<LL>::begin() const noexcept -> const_iterator
+        {
+            return m_labels.cbegin();
+        }
+
+        template <class LL>
+        inline auto xsorted_labels<LL>::end() const noexcept -> const_iterator
+        {
+            return m_labels.cend();
+        }
+
+        template <class LL>
+        inline auto xsorted_labels<LL>::cbegin() const noexcept -> const_iterator
+        {
+            return m_labels.cbegin();
+        }
+
+        template <class LL>
+        inline auto xsorted_labels<LL>::cend() const noexcept -> const_iterator
+        {
+            return m_labels.cend();
+        }
+    }
+
     /************************
      * xaxis implementation *
      ************************/
@@ -276,7 +897,7 @@ namespace xf
      */
     template <class L, class T, class MT>
     inline xaxis<L, T, MT>::xaxis()
-        : base_type(), m_index(), m_is_sorted(true)
+        : base_type(), p_index(), m_is_sorted(true)
     {
     }
 
@@ -288,7 +909,7 @@ namespace xf
      */
     template <class L, class T, class MT>
     inline xaxis<L, T, MT>::xaxis(const label_list& labels)
-        : base_type(labels), m_index(), m_is_sorted()
+        : base_type(labels), p_index(), m_is_sorted()
     {
         m_is_sorted = init_is_sorted();
         populate_index();
@@ -303,7 +924,7 @@ namespace xf
      */
     template <class L, class T, class MT>
     inline xaxis<L, T, MT>::xaxis(label_list&& labels)
-        : base_type(std::move(labels)), m_index(), m_is_sorted()
+        : base_type(std::move(labels)), p_index(), m_is_sorted()
     {
         m_is_sorted = init_is_sorted();
         populate_index();
@@ -320,7 +941,7 @@ namespace xf
      */
     template <class L, class T, class MT>
     inline xaxis<L, T, MT>::xaxis(const label_list& labels, bool is_sorted)
-        : base_type(labels), m_index(), m_is_sorted(is_sorted)
+        : base_type(labels), p_index(), m_is_sorted(is_sorted)
     {
         populate_index();
     }
@@ -337,7 +958,7 @@ namespace xf
 
     template <class L, class T, class MT>
     inline xaxis<L, T, MT>::xaxis(label_list&& labels, bool is_sorted)
-        : base_type(labels), m_index(), m_is_sorted(is_sorted)
+        : base_type(std::move(labels)), p_index(), m_is_sorted(is_sorted)
     {
         populate_index();
     }
@@ -348,7 +969,7 @@ namespace xf
      */
     template <class L, class T, class MT>
     inline xaxis<L, T, MT>::xaxis(std::initializer_list<key_type> init)
-        : base_type(init), m_index(), m_is_sorted()
+        : base_type(init), p_index(), m_is_sorted()
     {
         m_is_sorted = init_is_sorted();
         populate_index();
@@ -361,10 +982,11 @@ namespace xf
     template <class L, class T, class MT>
     template <class L1>
     inline xaxis<L, T, MT>::xaxis(xaxis_default<L1, T> axis)
-        : base_type(axis.labels()), m_index(), m_is_sorted(true)
+        : base_type(label_list(axis.size())), p_index(), m_is_sorted(true)
     {
         static_assert(std::is_same<L, L1>::value, "key_type L and key_type L1 must be the same");
-
+        auto& labels = this->mutable_labels();
+        std::iota(labels.begin(), labels.end(), L(0));
         populate_index();
     }
 
@@ -376,7 +998,7 @@ namespace xf
     template <class L, class T, class MT>
     template <class InputIt>
     inline xaxis<L, T, MT>::xaxis(InputIt first, InputIt last)
-        : base_type(first, last), m_index(), m_is_sorted()
+        : base_type(first, last), p_index(), m_is_sorted()
     {
         m_is_sorted = init_is_sorted();
         populate_index();
@@ -403,7 +1025,7 @@ namespace xf
     template <class L, class T, class MT>
     inline bool xaxis<L, T, MT>::contains(const key_type& key) const
     {
-        return m_index.count(key) != typename map_type::size_type(0);
+        return find_position(key) != this->size();
     }
 
     /**
@@ -414,7 +1036,37 @@ namespace xf
     template <class L, class T, class MT>
     inline auto xaxis<L, T, MT>::operator[](const key_type& key) const -> mapped_type
     {
-        return m_index.at(key);
+        size_type pos = find_position(key);
+        if (pos == this->size())
+        {
+            throw std::out_of_range("xaxis: label not found");
+        }
+        return mapped_type(pos);
+    }
+
+    /**
+     * Returns true if the axis contains the label equivalent to \c key. The
+     * key is converted to a label without being registered as one, see
+     * xinterned_string::lookup.
+     * @param key the label to search for.
+     */
+    template <class L, class T, class MT>
+    template <class S, class>
+    inline bool xaxis<L, T, MT>::contains(const S& key) const
+    {
+        return contains(detail::lookup_key<key_type>(key));
+    }
+
+    /**
+     * Returns the position of the label equivalent to \c key. If this last
+     * one is not found, an exception is thrown.
+     * @param key the label to search for.
+     */
+    template <class L, class T, class MT>
+    template <class S, class>
+    inline auto xaxis<L, T, MT>::operator[](const S& key) const -> mapped_type
+    {
+        return operator[](detail::lookup_key<key_type>(key));
     }
     //@}
 
@@ -460,8 +1112,54 @@ namespace xf
     template <class L, class T, class MT>
     inline auto xaxis<L, T, MT>::find(const key_type& key) const -> const_iterator
     {
-        auto map_iter = m_index.find(key);
-        return map_iter != m_index.end() ? cbegin() + map_iter->second : cend();
+        return cbegin() + static_cast<difference_type>(find_position(key));
+    }
+
+    /**
+     * Returns a constant iterator to the element with label equivalent to \c key,
+     * converted to a label without being registered as one. If no such element
+     * is found, past-the-end iterator is returned.
+     * @param key the label to search for.
+     */
+    template <class L, class T, class MT>
+    template <class S, class>
+    inline auto xaxis<L, T, MT>::find(const S& key) const -> const_iterator
+    {
+        return find(detail::lookup_key<key_type>(key));
+    }
+
+    /**
+     * Returns the position of the first label that is not less than \c key,
+     * or the size of the axis if there is no such label. The axis must be
+     * sorted, otherwise an exception is thrown.
+     * @param key the label to search for.
+     */
+    template <class L, class T, class MT>
+    inline auto xaxis<L, T, MT>::lower_bound_index(const key_type& key) const -> size_type
+    {
+        if (!m_is_sorted)
+        {
+            throw std::runtime_error("lower_bound_index forbidden for unsorted axis");
+        }
+        const auto& labels = this->labels();
+        return static_cast<size_type>(detail::branchless_lower_bound(labels.cbegin(), labels.cend(), key) - labels.cbegin());
+    }
+
+    /**
+     * Returns the position of the first label that is greater than \c key,
+     * or the size of the axis if there is no such label. The axis must be
+     * sorted, otherwise an exception is thrown.
+     * @param key the label to search for.
+     */
+    template <class L, class T, class MT>
+    inline auto xaxis<L, T, MT>::upper_bound_index(const key_type& key) const -> size_type
+    {
+        if (!m_is_sorted)
+        {
+            throw std::runtime_error("upper_bound_index forbidden for unsorted axis");
+        }
+        const auto& labels = this->labels();
+        return static_cast<size_type>(detail::branchless_upper_bound(labels.cbegin(), labels.cend(), key) - labels.cbegin());
     }
 
     /**
@@ -512,6 +1210,10 @@ namespace xf
     template <class... Args>
     inline bool xaxis<L, T, MT>::intersect(const Args&... axes)
     {
+        if (shares_labels(axes...))
+        {
+            return true;
+        }
         bool res = true;
         if (all_sorted(*this, axes...))
         {
@@ -520,7 +1222,7 @@ namespace xf
         }
         else
         {
-            res = intersect_unsorted(axes.labels()...);
+            res = intersect_not_sorted(MT(), axes...);
         }
         return res;
     }
@@ -529,10 +1231,7 @@ namespace xf
     template <class L, class T, class MT>
     inline void xaxis<L, T, MT>::populate_index()
     {
-        for(size_type i = 0; i < this->labels().size(); ++i)
-        {
-            m_index[this->labels()[i]] = T(i);
-        }
+        populate_index_impl(MT());
     }
 
     template <class L, class T, class MT>
@@ -545,13 +1244,98 @@ namespace xf
     template <class L, class T, class MT>
     inline auto xaxis<L, T, MT>::find_index(const key_type& key) const -> typename map_type::const_iterator
     {
-        return m_index.find(key);
+        return p_index->find(key);
+    }
+
+    // Returns the position of the specified label, or the size
+    // of the axis if the label is not found.
+    template <class L, class T, class MT>
+    inline auto xaxis<L, T, MT>::find_position(const key_type& key) const -> size_type
+    {
+        return find_position_impl(key, MT());
+    }
+
+    template <class L, class T, class MT>
+    template <class Tag>
+    inline auto xaxis<L, T, MT>::find_position_impl(const key_type& key, Tag) const -> size_type
+    {
+        if (!p_index)
+        {
+            return this->size();
+        }
+        auto map_iter = p_index->find(key);
+        return map_iter != p_index->end() ? size_type(map_iter->second) : this->size();
+    }
+
+    template <class L, class T, class MT>
+    inline auto xaxis<L, T, MT>::find_position_impl(const key_type& key, sorted_tag) const -> size_type
+    {
+        const auto& labels = this->labels();
+        auto iter = detail::branchless_lower_bound(labels.cbegin(), labels.cend(), key);
+        return (iter != labels.cend() && *iter == key) ? static_cast<size_type>(iter - labels.cbegin()) : labels.size();
+    }
+
+    template <class L, class T, class MT>
+    template <class Tag>
+    inline void xaxis<L, T, MT>::populate_index_impl(Tag)
+    {
+        // The previous map may be shared with other axes, a new one is built.
+        auto index = std::make_shared<map_type>();
+        const auto& labels = this->labels();
+        for(size_type i = 0; i < labels.size(); ++i)
+        {
+            (*index)[labels[i]] = T(i);
+        }
+        p_index = std::move(index);
+    }
+
+    template <class L, class T, class MT>
+    inline void xaxis<L, T, MT>::populate_index_impl(sorted_tag)
+    {
+        if (!m_is_sorted)
+        {
+            throw std::invalid_argument("xaxis: labels must be sorted when using sorted_tag");
+        }
+    }
+
+    // Detaches the map from the other copies of the axis.
+    template <class L, class T, class MT>
+    inline auto xaxis<L, T, MT>::mutable_index() -> map_type&
+    {
+        if (!p_index)
+        {
+            p_index = std::make_shared<map_type>();
+        }
+        else if (p_index.use_count() != 1)
+        {
+            p_index = std::make_shared<map_type>(*p_index);
+        }
+        return *p_index;
+    }
+
+    // Returns true if all the arguments share the list of labels
+    // of this axis.
+    template <class L, class T, class MT>
+    template <class... Args>
+    inline bool xaxis<L, T, MT>::shares_labels(const Args&... axes) const noexcept
+    {
+        const label_list& labels = this->labels();
+        bool res = sizeof...(Args) != 0;
+        for (bool shared : std::initializer_list<bool>{ detail::shares_label_list(labels, axes.labels())... })
+        {
+            res &= shared;
+        }
+        return res;
     }
 
     template <class L, class T, class MT>
     template <class... Args>
     inline bool xaxis<L, T, MT>::merge_impl(const Args&... axes)
     {
+        if (shares_labels(axes...))
+        {
+            return true;
+        }
         bool res = true;
         if(all_sorted(*this, axes...))
         {
@@ -560,24 +1344,91 @@ namespace xf
         }
         else
         {
-            m_is_sorted = false;
-            if (m_index.empty())
-            {
-                populate_index();
-            }
-            res = merge_unsorted(false, axes.labels()...);
+            res = merge_not_sorted(MT(), axes...);
+        }
+        return res;
+    }
+
+    template <class L, class T, class MT>
+    template <class Tag, class... Args>
+    inline bool xaxis<L, T, MT>::merge_not_sorted(Tag, const Args&... axes)
+    {
+        m_is_sorted = false;
+        if (!p_index || p_index->empty())
+        {
+            populate_index();
+        }
+        return merge_unsorted(false, axes.labels()...);
+    }
+
+    // An axis with sorted_tag remains sorted: unsorted labels are
+    // sorted before being merged.
+    template <class L, class T, class MT>
+    template <class... Args>
+    inline bool xaxis<L, T, MT>::merge_not_sorted(sorted_tag, const Args&... axes)
+    {
+        bool res = m_is_sorted;
+        for (bool sorted : std::initializer_list<bool>{ axes.is_sorted()... })
+        {
+            res &= sorted;
+        }
+        sort_labels();
+        res &= merge_to(this->mutable_labels(), detail::xsorted_labels<label_list>(axes)...);
+        return res;
+    }
+
+    template <class L, class T, class MT>
+    template <class Tag, class... Args>
+    inline bool xaxis<L, T, MT>::intersect_not_sorted(Tag, const Args&... axes)
+    {
+        return intersect_unsorted(axes.labels()...);
+    }
+
+    template <class L, class T, class MT>
+    template <class... Args>
+    inline bool xaxis<L, T, MT>::intersect_not_sorted(sorted_tag, const Args&... axes)
+    {
+        bool res = true;
+        for (bool sorted : std::initializer_list<bool>{ axes.is_sorted()... })
+        {
+            res &= sorted;
         }
+        res &= intersect_to(this->mutable_labels(), detail::xsorted_labels<label_list>(axes)...);
         return res;
     }
 
+    template <class L, class T, class MT>
+    inline void xaxis<L, T, MT>::sort_labels()
+    {
+        if (!m_is_sorted)
+        {
+            auto& labels = this->mutable_labels();
+            std::sort(labels.begin(), labels.end());
+            labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+            m_is_sorted = true;
+        }
+    }
+
     template <class L, class T, class MT>
     template <class Arg1, class... Args>
     inline bool xaxis<L, T, MT>::merge_empty(const Arg1& a, const Args&... axes)
     {
-        this->mutable_labels() = a.labels();
+        const auto& labels = a.labels();
+        this->mutable_labels() = label_list(labels.begin(), labels.end());
+        m_is_sorted = a.is_sorted();
         return merge_impl(axes...);
     }
 
+    // Shares the labels and the map of the first axis instead
+    // of copying them.
+    template <class L, class T, class MT>
+    template <class... Args>
+    inline bool xaxis<L, T, MT>::merge_empty(const self_type& a, const Args&... axes)
+    {
+        *this = a;
+        return sizeof...(Args) == 0 ? true : merge_impl(axes...);
+    }
+
     template <class L, class T, class MT>
     inline bool xaxis<L, T, MT>::merge_empty()
     {
@@ -628,27 +1479,40 @@ namespace xf
         }
         else if(output_iter == output_end)
         {
-            std::copy(a.begin(), a.begin() + std::distance(input_iter, input_end),
-                      std::inserter(labels, labels.begin()));
+            labels.insert(labels.begin(), a.begin(), a.begin() + std::distance(input_iter, input_end));
             populate_index();
             res &= broadcasting;
         }
         else
         {
-            while(input_iter != input_end)
+            // New labels are visited backward from the end of the unmatched
+            // part of the input, as the former one-by-one insertion did. They
+            // are prepended when the axes share a common suffix, which
+            // restores their input order, and appended in visiting order
+            // otherwise.
+            bool prepend = output_iter != labels.rbegin();
+            auto input_last = a.begin() + std::distance(input_iter, input_end);
+            label_list new_labels;
+            auto& index = mutable_index();
+            for (auto it = input_last; it != a.begin();)
             {
-                if(!contains(*input_iter))
+                --it;
+                if (index.emplace(*it, T(0)).second)
                 {
-                    if(output_iter != labels.rbegin())
-                    {
-                        labels.insert(labels.begin(), *input_iter);
-                    }
-                    else
-                    {
-                        labels.push_back(*input_iter);
-                    }
+                    new_labels.push_back(*it);
                 }
-                ++input_iter;
+            }
+            if (prepend)
+            {
+                std::reverse(new_labels.begin(), new_labels.end());
+                new_labels.reserve(new_labels.size() + labels.size());
+                std::move(labels.begin(), labels.end(), std::back_inserter(new_labels));
+                labels.swap(new_labels);
+            }
+            else
+            {
+                labels.reserve(labels.size() + new_labels.size());
+                std::move(new_labels.begin(), new_labels.end(), std::back_inserter(labels));
             }
             populate_index();
             res = false;
@@ -667,32 +1531,34 @@ namespace xf
     inline bool xaxis<L, T, MT>::intersect_unsorted(const Arg& al, const Args&... axes_labels)
     {
         bool res = intersect_unsorted(axes_labels...);
+        map_type input_index;
+        for (size_type i = 0; i < al.size(); ++i)
+        {
+            input_index.emplace(al[i], T(i));
+        }
         auto& labels = this->mutable_labels();
-        auto iter = labels.begin();
-        auto iter_end = labels.end();
-        bool must_populate = false;
-        while (iter != iter_end)
+        size_type out = 0;
+        for (size_type i = 0; i < labels.size(); ++i)
         {
-            auto it = std::find(al.begin(), al.end(), *iter);
-            if (it == al.end())
-            {
-                iter = labels.erase(iter, iter + 1);
-                iter_end = labels.end();
-                res = false;
-                must_populate = true;
-            }
-            else
+            auto it = input_index.find(labels[i]);
+            if (it != input_index.end())
             {
-                if (it - al.begin() != iter - labels.begin())
+                if (size_type(it->second) != out)
                 {
                     res = false;
                 }
-                ++iter;
+                if (out != i)
+                {
+                    labels[out] = std::move(labels[i]);
+                }
+                ++out;
             }
         }
-        if (must_populate)
+        if (out != labels.size())
         {
+            labels.erase(labels.begin() + static_cast<difference_type>(out), labels.end());
             populate_index();
+            res = false;
         }
         return res;
     }
@@ -801,6 +1667,93 @@ namespace xf
         return lhs.less_than(rhs);
     }
 
+    /****************************************
+     * xaxis_sorted_iterator implementation *
+     ****************************************/
+
+    template <class L, class T>
+    inline xaxis_sorted_iterator<L, T>::xaxis_sorted_iterator(const container_type* c, label_iterator it)
+        : m_first(c->labels().cbegin()), m_it(it), m_value()
+    {
+    }
+
+    template <class L, class T>
+    inline auto xaxis_sorted_iterator<L, T>::operator++() -> self_type&
+    {
+        ++m_it;
+        return *this;
+    }
+
+    template <class L, class T>
+    inline auto xaxis_sorted_iterator<L, T>::operator--() -> self_type&
+    {
+        --m_it;
+        return *this;
+    }
+
+    template <class L, class T>
+    inline auto xaxis_sorted_iterator<L, T>::operator+=(difference_type n) -> self_type&
+    {
+        m_it += n;
+        return *this;
+    }
+
+    template <class L, class T>
+    inline auto xaxis_sorted_iterator<L, T>::operator-=(difference_type n) -> self_type&
+    {
+        m_it -= n;
+        return *this;
+    }
+
+    template <class L, class T>
+    inline auto xaxis_sorted_iterator<L, T>::operator-(const self_type& rhs) const -> difference_type
+    {
+        return m_it - rhs.m_it;
+    }
+
+    template <class L, class T>
+    inline auto xaxis_sorted_iterator<L, T>::operator*() const -> reference
+    {
+        m_value = value_type(*m_it, static_cast<mapped_type>(m_it - m_first));
+        return m_value;
+    }
+
+    template <class L, class T>
+    inline auto xaxis_sorted_iterator<L, T>::operator->() const -> pointer
+    {
+        return &(operator*());
+    }
+
+    template <class L, class T>
+    inline bool xaxis_sorted_iterator<L, T>::equal(const self_type& rhs) const noexcept
+    {
+        return m_it == rhs.m_it;
+    }
+
+    template <class L, class T>
+    inline bool xaxis_sorted_iterator<L, T>::less_than(const self_type& rhs) const noexcept
+    {
+        return m_it < rhs.m_it;
+    }
+
+    template <class L, class T>
+    inline typename xaxis_sorted_iterator<L, T>::difference_type operator-(const xaxis_sorted_iterator<L, T>& lhs, const xaxis_sorted_iterator<L, T>& rhs)
+    {
+        return lhs.operator-(rhs);
+    }
+
+    template <class L, class T>
+    inline bool operator==(const xaxis_sorted_iterator<L, T>& lhs, const xaxis_sorted_iterator<L, T>& rhs) noexcept
+    {
+        return lhs.equal(rhs);
+    }
+
+    template <class L, class T>
+    inline bool operator<(const xaxis_sorted_iterator<L, T>& lhs, const xaxis_sorted_iterator<L, T>& rhs) noexcept
+    {
+        return lhs.less_than(rhs);
+    }
+
     /********************************
      * axis builders implementation *
      ********************************/
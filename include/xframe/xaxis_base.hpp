@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <vector>
 
 namespace xf
@@ -33,6 +34,11 @@ namespace xf
      * mapping of labels to positions in a given dimension. The axis_base class
      * embeds the list of labels only, the mapping is hold by the inheriting classes.
      *
+     * The list of labels is shared between the copies of an axis, and copied
+     * on the first modification of one of them. Copying an axis is therefore
+     * cheap, and the copies of an axis compare equal without comparing their
+     * labels.
+     *
      * @tparam D The derived type, i.e. the inheriting class for which xaxis_base
      *           provides the interface.
      */
@@ -93,7 +99,7 @@ namespace xf
         xaxis_base(xaxis_base&&) = default;
         xaxis_base& operator=(xaxis_base&&) = default;
 
-        label_list& mutable_labels() noexcept;
+        label_list& mutable_labels();
 
         template <class F>
         label_list filter_labels(const F& f) const noexcept;
@@ -101,7 +107,13 @@ namespace xf
         template <class F>
         label_list filter_labels(const F& f, size_type size) const noexcept;
 
-        label_list m_labels;
+    private:
+
+        using label_storage = std::shared_ptr<label_list>;
+
+        static const label_list& empty_labels() noexcept;
+
+        label_storage p_labels;
     };
 
     template <class D1, class D2>
@@ -128,32 +140,32 @@ namespace xf
 
     template <class D>
     inline xaxis_base<D>::xaxis_base()
-        : m_labels()
+        : p_labels()
     {
     }
 
     template <class D>
     inline xaxis_base<D>::xaxis_base(const label_list& labels)
-        : m_labels(labels)
+        : p_labels(std::make_shared<label_list>(labels))
     {
     }
 
     template <class D>
     inline xaxis_base<D>::xaxis_base(label_list&& labels)
-        : m_labels(std::move(labels))
+        : p_labels(std::make_shared<label_list>(std::move(labels)))
     {
     }
 
     template <class D>
     inline xaxis_base<D>::xaxis_base(std::initializer_list<key_type> init)
-        : m_labels(init)
+        : p_labels(std::make_shared<label_list>(init))
     {
     }
 
     template <class D>
     template <class InputIt>
     inline xaxis_base<D>::xaxis_base(InputIt first, InputIt last)
-        : m_labels(first, last)
+        : p_labels(std::make_shared<label_list>(first, last))
     {
     }
 
@@ -202,7 +214,7 @@ namespace xf
     template <class D>
     inline auto xaxis_base<D>::labels() const noexcept -> const label_list&
     {
-        return m_labels;
+        return p_labels ? *p_labels : empty_labels();
     }
 
     /**
@@ -212,7 +224,7 @@ namespace xf
     template <class D>
     inline auto xaxis_base<D>::label(size_type i) const -> key_type
     {
-        return m_labels[i];
+        return labels()[i];
     }
 
     /**
@@ -221,7 +233,7 @@ namespace xf
     template <class D>
     inline bool xaxis_base<D>::empty() const noexcept
     {
-        return m_labels.empty();
+        return labels().empty();
     }
 
     /**
@@ -230,7 +242,7 @@ namespace xf
     template <class D>
     inline auto xaxis_base<D>::size() const noexcept -> size_type
     {
-        return m_labels.size();
+        return labels().size();
     }
     //@}
 
@@ -299,10 +311,19 @@ namespace xf
     }
     //@}
 
+    // Detaches the labels from the other copies of the axis.
     template <class D>
-    inline auto xaxis_base<D>::mutable_labels() noexcept -> label_list&
+    inline auto xaxis_base<D>::mutable_labels() -> label_list&
     {
-        return m_labels;
+        if (!p_labels)
+        {
+            p_labels = std::make_shared<label_list>();
+        }
+        else if (p_labels.use_count() != 1)
+        {
+            p_labels = std::make_shared<label_list>(*p_labels);
+        }
+        return *p_labels;
     }
 
     template <class D>
@@ -310,7 +331,7 @@ namespace xf
     inline auto xaxis_base<D>::filter_labels(const F& f) const noexcept -> label_list
     {
         label_list l;
-        std::copy_if(m_labels.cbegin(), m_labels.cend(), std::back_inserter(l), f);
+        std::copy_if(labels().cbegin(), labels().cend(), std::back_inserter(l), f);
         return l;
     }
 
@@ -319,20 +340,64 @@ namespace xf
     inline auto xaxis_base<D>::filter_labels(const F& f, size_type size) const noexcept -> label_list
     {
         label_list l(size);
-        std::copy_if(m_labels.cbegin(), m_labels.cend(), l.begin(), f);
+        std::copy_if(labels().cbegin(), labels().cend(), l.begin(), f);
         return l;
     }
 
+    template <class D>
+    inline auto xaxis_base<D>::empty_labels() noexcept -> const label_list&
+    {
+        static const label_list empty;
+        return empty;
+    }
+
+    namespace detail
+    {
+        // Axes sharing their list of labels are equal without comparing
+        // the labels. Axes that do not store their labels never share them.
+
+        template <class D1, class D2>
+        inline bool axis_same_labels(const D1&, const D2&) noexcept
+        {
+            return false;
+        }
+
+        template <class D>
+        inline auto axis_same_labels(const D& lhs, const D& rhs) noexcept
+            -> decltype(&(lhs.labels()) == &(rhs.labels()))
+        {
+            return &(lhs.labels()) == &(rhs.labels());
+        }
+    }
+
     /**
      * Returns true is \c lhs and \c rhs are equivalent axes, i.e. they contain the same
-     * label - position pairs.
+     * label - position pairs. Axes sharing their list of labels are equal without
+     * comparing the labels.
      * @param lhs an axis.
      * @param rhs an axis.
      */
     template <class D1, class D2>
     inline bool operator==(const xaxis_base<D1>& lhs, const xaxis_base<D2>& rhs) noexcept
     {
-        return lhs.labels() == rhs.labels();
+        const D1& dlhs = lhs.derived_cast();
+        const D2& drhs = rhs.derived_cast();
+        if (detail::axis_same_labels(dlhs, drhs))
+        {
+            return true;
+        }
+        if (dlhs.size() != drhs.size())
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < dlhs.size(); ++i)
+        {
+            if (!(dlhs.label(i) == drhs.label(i)))
+            {
+                return false;
+            }
+        }
+        return true;
     }
 
     /**
@@ -350,9 +415,12 @@ namespace xf
     template <class OS, class D>
     inline OS& operator<<(OS& out, const xaxis_base<D>& axis)
     {
-        using iterator = std::ostream_iterator<typename xaxis_base<D>::key_type, typename OS::char_type, typename OS::traits_type>;
+        const D& daxis = axis.derived_cast();
         out << '(';
-        std::copy(axis.labels().begin(), axis.labels().end(), iterator(out, ", "));
+        for (std::size_t i = 0; i < daxis.size(); ++i)
+        {
+            out << daxis.label(i) << ", ";
+        }
         out << ')';
         return out;
     }
@@ -11,12 +11,18 @@
 #ifndef XFRAME_XAXIS_DEFAULT_HPP
 #define XFRAME_XAXIS_DEFAULT_HPP
 
+#include <algorithm>
+#include <initializer_list>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <ostream>
 #include <iterator>
 
 #include "xtl/xiterator_base.hpp"
+#include "xtl/xtype_traits.hpp"
 
 #include "xaxis_base.hpp"
 #include "xaxis.hpp"
@@ -39,6 +45,10 @@ namespace xf
      *
      * The xaxis_default class is used for modeling a default axis
      * that holds a contiguous sequence of integral labels starting at 0.
+     * Since labels and positions are the same, the axis only stores its
+     * size; lookups, iteration, comparison, merge and intersection are
+     * computed arithmetically. The list of labels is only built when
+     * \c labels() is called.
      *
      * @tparam L the type of labels. This must be an integral type.
      * @tparam T the integer type used to represent positions. Default value is
@@ -71,6 +81,12 @@ namespace xf
 
         explicit xaxis_default(size_type size = 0);
 
+        label_list labels() const;
+        key_type label(size_type i) const;
+
+        bool empty() const noexcept;
+        size_type size() const noexcept;
+
         bool is_sorted() const noexcept;
 
         bool contains(const key_type& key) const;
@@ -84,23 +100,41 @@ namespace xf
 
         const_iterator find(const key_type& key) const;
 
+        size_type lower_bound_index(const key_type& key) const noexcept;
+        size_type upper_bound_index(const key_type& key) const noexcept;
+
         const_iterator cbegin() const noexcept;
         const_iterator cend() const noexcept;
 
-    protected:
+        template <class... Args>
+        bool merge(const Args&... axes);
 
-        void populate_labels(const size_type& size = 0);
+        template <class... Args>
+        bool intersect(const Args&... axes);
 
     private:
 
-        template <class... Args>
-        bool merge(const Args&... /*axes*/);
+        size_type m_size;
+    };
 
-        template <class... Args>
-        bool intersect(const Args&... /*axes*/);
+    template <class L, class T>
+    bool operator==(const xaxis_default<L, T>& lhs, const xaxis_default<L, T>& rhs) noexcept;
+
+    template <class L, class T>
+    bool operator!=(const xaxis_default<L, T>& lhs, const xaxis_default<L, T>& rhs) noexcept;
 
-        template <class L1, class T1, class MT1>
-        friend class xaxis_variant;
+    /********************************
+     * is_axis_default metafunction *
+     ********************************/
+
+    template <class T>
+    struct is_axis_default : std::false_type
+    {
+    };
+
+    template <class L, class T>
+    struct is_axis_default<xaxis_default<L, T>> : std::true_type
+    {
     };
 
     /*************************
@@ -188,9 +222,49 @@ namespace xf
      */
     template <class L, class T>
     inline xaxis_default<L, T>::xaxis_default(size_type size)
-        : base_type()
+        : base_type(), m_size(size)
     {
-        populate_labels(size);
+    }
+
+    /**
+     * Builds and returns the list of labels contained in the axis. This
+     * allocates a list of \c size() labels, prefer \c label or the
+     * iterators when the whole list is not needed.
+     */
+    template <class L, class T>
+    inline auto xaxis_default<L, T>::labels() const -> label_list
+    {
+        label_list res(m_size);
+        std::iota(res.begin(), res.end(), key_type(0));
+        return res;
+    }
+
+    /**
+     * Return the i-th label of the axis.
+     * @param i the position of the label.
+     */
+    template <class L, class T>
+    inline auto xaxis_default<L, T>::label(size_type i) const -> key_type
+    {
+        return key_type(i);
+    }
+
+    /**
+     * Checks if the axis has no labels.
+     */
+    template <class L, class T>
+    inline bool xaxis_default<L, T>::empty() const noexcept
+    {
+        return m_size == size_type(0);
+    }
+
+    /**
+     * Returns the number of labels in the axis.
+     */
+    template <class L, class T>
+    inline auto xaxis_default<L, T>::size() const noexcept -> size_type
+    {
+        return m_size;
     }
 
     /**
@@ -209,7 +283,7 @@ namespace xf
     template <class L, class T>
     inline bool xaxis_default<L, T>::contains(const key_type& key) const
     {
-        return key_type(0) <= key && key < key_type(this->size());
+        return key_type(0) <= key && static_cast<size_type>(key) < m_size;
     }
 
     /**
@@ -220,7 +294,11 @@ namespace xf
     template <class L, class T>
     inline auto xaxis_default<L, T>::operator[](const key_type& key) const -> mapped_type
     {
-        return mapped_type(this->labels().at(key));
+        if (!contains(key))
+        {
+            throw std::out_of_range("xaxis_default: label not found");
+        }
+        return mapped_type(key);
     }
 
     /**
@@ -231,7 +309,16 @@ namespace xf
     template <class F>
     inline auto xaxis_default<L, T>::filter(const F& f) const noexcept -> axis_type
     {
-        return axis_type(base_type::filter_labels(f), true);
+        label_list l;
+        for (size_type i = 0; i < m_size; ++i)
+        {
+            key_type key = key_type(i);
+            if (f(key))
+            {
+                l.push_back(key);
+            }
+        }
+        return axis_type(std::move(l), true);
     }
 
     /**
@@ -245,7 +332,17 @@ namespace xf
     template <class F>
     inline auto xaxis_default<L, T>::filter(const F& f, size_type size) const noexcept -> axis_type
     {
-        return axis_type(base_type::filter_labels(f, size), true);
+        label_list l(size);
+        auto out = l.begin();
+        for (size_type i = 0; i < m_size; ++i)
+        {
+            key_type key = key_type(i);
+            if (f(key))
+            {
+                *out++ = key;
+            }
+        }
+        return axis_type(std::move(l), true);
     }
 
     /**
@@ -259,6 +356,36 @@ namespace xf
         return contains(key) ? const_iterator(mapped_type(key)) : cend();
     }
 
+    /**
+     * Returns the position of the first label that is not less than \c key,
+     * or the size of the axis if there is no such label.
+     * @param key the label to search for.
+     */
+    template <class L, class T>
+    inline auto xaxis_default<L, T>::lower_bound_index(const key_type& key) const noexcept -> size_type
+    {
+        if (key <= key_type(0))
+        {
+            return size_type(0);
+        }
+        return std::min(static_cast<size_type>(key), m_size);
+    }
+
+    /**
+     * Returns the position of the first label that is greater than \c key,
+     * or the size of the axis if there is no such label.
+     * @param key the label to search for.
+     */
+    template <class L, class T>
+    inline auto xaxis_default<L, T>::upper_bound_index(const key_type& key) const noexcept -> size_type
+    {
+        if (key < key_type(0))
+        {
+            return size_type(0);
+        }
+        return std::min(static_cast<size_type>(key) + 1, m_size);
+    }
+
     /**
      * Returns a constant iterator to the first element of the axis.
      * This element is a pair label - position.
@@ -276,31 +403,69 @@ namespace xf
     template <class L, class T>
     inline auto xaxis_default<L, T>::cend() const noexcept -> const_iterator
     {
-        return const_iterator(mapped_type(this->size()));
+        return const_iterator(mapped_type(m_size));
     }
 
+    /**
+     * Merges all the default axes arguments into this one. Since all the
+     * axes hold contiguous labels starting at 0, the result is the
+     * default axis of maximal size.
+     * @param axes the default axes to merge.
+     * @return true if this axis and all the arguments had the same size.
+     */
     template <class L, class T>
-    inline void xaxis_default<L, T>::populate_labels(const size_type& size)
+    template <class... Args>
+    inline bool xaxis_default<L, T>::merge(const Args&... axes)
     {
-        auto& labels = this->mutable_labels();
-        for(size_type i = 0; i < size; ++i)
+        static_assert(xtl::conjunction<is_axis_default<Args>...>::value, "xaxis_default can only be merged with default axes");
+        size_type new_size = std::max({ m_size, axes.size()... });
+        bool res = (m_size == size_type(0) || m_size == new_size);
+        for (size_type s : std::initializer_list<size_type>{ axes.size()... })
         {
-            labels.push_back(key_type(i));
+            res &= (s == new_size);
         }
+        m_size = new_size;
+        return res;
     }
 
+    /**
+     * Replaces this axis with its intersection with the default axes
+     * arguments, i.e. the default axis of minimal size.
+     * @param axes the default axes to intersect.
+     * @return true if the intersection is equivalent to this axis.
+     */
     template <class L, class T>
     template <class... Args>
-    inline bool xaxis_default<L, T>::merge(const Args&... /*axes*/)
+    inline bool xaxis_default<L, T>::intersect(const Args&... axes)
     {
-        throw std::runtime_error("merge forbidden for xaxis_default");
+        static_assert(xtl::conjunction<is_axis_default<Args>...>::value, "xaxis_default can only be intersected with default axes");
+        size_type new_size = std::min({ m_size, axes.size()... });
+        bool res = (new_size == m_size);
+        m_size = new_size;
+        return res;
     }
 
+    /**
+     * Returns true if \c lhs and \c rhs are equivalent default axes,
+     * i.e. they have the same size.
+     * @param lhs a default axis.
+     * @param rhs a default axis.
+     */
     template <class L, class T>
-    template <class... Args>
-    inline bool xaxis_default<L, T>::intersect(const Args&... /*axes*/)
+    inline bool operator==(const xaxis_default<L, T>& lhs, const xaxis_default<L, T>& rhs) noexcept
+    {
+        return lhs.size() == rhs.size();
+    }
+
+    /**
+     * Returns true if \c lhs and \c rhs are not equivalent default axes.
+     * @param lhs a default axis.
+     * @param rhs a default axis.
+     */
+    template <class L, class T>
+    inline bool operator!=(const xaxis_default<L, T>& lhs, const xaxis_default<L, T>& rhs) noexcept
     {
-        throw std::runtime_error("intersect forbidden for xaxis_default");
+        return !(lhs == rhs);
     }
 
     /****************************************
@@ -58,12 +58,23 @@ namespace xf
 
         using expression_tag = xaxis_expression_tag;
 
+        static constexpr std::size_t leaf_count = 1;
+
         template <class AX>
         xaxis_expression_leaf(AX&& n_axis) noexcept;
 
         template <std::size_t N = std::numeric_limits<size_type>::max()>
         const_reference operator()(const selector_sequence_type<N>& selector) const;
 
+        template <class DM>
+        void resolve_positions(const DM& dim_mapping, std::size_t* positions) const;
+
+        template <class I>
+        const_reference element(const I& index, const std::size_t* positions) const;
+
+        template <class T, class S>
+        bool tabulate(T& tables, const std::size_t* positions, const S& shape) const;
+
     private:
 
         xaxis_closure_t<CTA> m_named_axis;
@@ -101,6 +112,48 @@ namespace xf
         }
         throw std::runtime_error(std::string("Missing label for axis ") + std::string(m_named_axis.name()));
     }
+
+    /**
+     * Stores the position of the named axis in the dimension mapping.
+     * @param dim_mapping the dimension mapping.
+     * @param positions the position to fill.
+     */
+    template <class CTA>
+    template <class DM>
+    inline void xaxis_expression_leaf<CTA>::resolve_positions(const DM& dim_mapping, std::size_t* positions) const
+    {
+        if (!dim_mapping.contains(m_named_axis.name()))
+        {
+            throw std::runtime_error(std::string("Missing label for axis ") + std::string(m_named_axis.name()));
+        }
+        *positions = static_cast<std::size_t>(dim_mapping[m_named_axis.name()]);
+    }
+
+    /**
+     * Returns the label from the xnamed_axis, given an index and the
+     * position resolved by resolve_positions.
+     * @param index the index, with one value per dimension.
+     * @param positions the resolved position.
+     */
+    template <class CTA>
+    template <class I>
+    inline auto xaxis_expression_leaf<CTA>::element(const I& index, const std::size_t* positions) const -> const_reference
+    {
+        return m_named_axis.label(static_cast<size_type>(index[positions[0]]));
+    }
+
+    /**
+     * Evaluates the leaf once per label in \c tables.
+     * @param tables the xaxis_mask_tables to fill.
+     * @param positions the position filled by resolve_positions.
+     * @param shape the shape of the masked variable.
+     */
+    template <class CTA>
+    template <class T, class S>
+    inline bool xaxis_expression_leaf<CTA>::tabulate(T& tables, const std::size_t* positions, const S& shape) const
+    {
+        return tables.tabulate_single_axis(*this, positions, leaf_count, shape);
+    }
 }
 
 #endif
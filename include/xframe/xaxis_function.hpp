@@ -11,8 +11,14 @@
 #ifndef XFRAME_XAXIS_FUNCTION_HPP
 #define XFRAME_XAXIS_FUNCTION_HPP
 
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
 #include "xtensor/xoptional.hpp"
 #include "xtensor/xgenerator.hpp"
+#include "xtensor/xoperation.hpp"
 
 #include "xframe_expression.hpp"
 #include "xframe_utils.hpp"
@@ -21,6 +27,22 @@
 
 namespace xf
 {
+    namespace detail
+    {
+        // Number of leaves of the axis expressions E preceding the I-th one,
+        // i.e. offset of its positions in the positions of a function.
+        template <std::size_t I, class... E>
+        struct axis_leaf_offset : std::integral_constant<std::size_t, 0>
+        {
+        };
+
+        template <std::size_t I, class E, class... R>
+        struct axis_leaf_offset<I, E, R...>
+            : std::integral_constant<std::size_t, I == 0 ? 0 : E::leaf_count + axis_leaf_offset<(I == 0 ? 0 : I - 1), R...>::value>
+        {
+        };
+    }
+
     /******************
      * xaxis_function *
      ******************/
@@ -59,17 +81,43 @@ namespace xf
 
         using expression_tag = xaxis_expression_tag;
 
+        static constexpr std::size_t leaf_count = detail::axis_leaf_offset<sizeof...(CT), std::decay_t<xaxis_expression_closure_t<CT>>...>::value;
+
         template <class Func, class U = std::enable_if<!std::is_base_of<Func, self_type>::value>>
         xaxis_function(Func&& f, CT... e) noexcept;
 
         template <std::size_t N = dynamic()>
         const_reference operator()(const selector_sequence_type<N>& selector) const;
 
+        template <class DM>
+        void resolve_positions(const DM& dim_mapping, std::size_t* positions) const;
+
+        template <class I>
+        const_reference element(const I& index, const std::size_t* positions) const;
+
+        template <class T, class S>
+        bool tabulate(T& tables, const std::size_t* positions, const S& shape) const;
+
     private:
 
         template <std::size_t N, std::size_t... I>
         const_reference evaluate(std::index_sequence<I...>, const selector_sequence_type<N>& selector) const;
 
+        template <class DM, std::size_t... I>
+        void resolve_positions_impl(std::index_sequence<I...>, const DM& dim_mapping, std::size_t* positions) const;
+
+        template <class Idx, std::size_t... I>
+        const_reference evaluate_element(std::index_sequence<I...>, const Idx& index, const std::size_t* positions) const;
+
+        template <class T, class S, std::size_t... I>
+        bool tabulate_impl(std::true_type, std::index_sequence<I...>, T& tables, const std::size_t* positions, const S& shape) const;
+
+        template <class T, class S, std::size_t... I>
+        bool tabulate_impl(std::false_type, std::index_sequence<I...>, T& tables, const std::size_t* positions, const S& shape) const;
+
+        template <std::size_t I>
+        using leaf_offset = detail::axis_leaf_offset<I, std::decay_t<xaxis_expression_closure_t<CT>>...>;
+
         std::tuple<xaxis_expression_closure_t<CT>...> m_e;
         functor_type m_f;
     };
@@ -126,12 +174,226 @@ namespace xf
 #endif
     }
 
+    /**
+     * Resolves the named axes of the function against a dimension mapping,
+     * so that it can be evaluated with element without comparing names.
+     * @param dim_mapping the dimension mapping.
+     * @param positions the positions to fill, \c leaf_count values.
+     * @throw std::runtime_error if an axis is not in the dimension mapping.
+     */
+    template <class F, class R, class... CT>
+    template <class DM>
+    inline void xaxis_function<F, R, CT...>::resolve_positions(const DM& dim_mapping, std::size_t* positions) const
+    {
+        resolve_positions_impl(std::make_index_sequence<sizeof...(CT)>(), dim_mapping, positions);
+    }
+
+    /**
+     * Returns an evaluation of the xaxis_function given an index, with one
+     * value per dimension, and the positions filled by resolve_positions.
+     * @param index the index where to evaluate the function.
+     * @param positions the resolved positions.
+     */
+    template <class F, class R, class... CT>
+    template <class I>
+    inline auto xaxis_function<F, R, CT...>::element(const I& index, const std::size_t* positions) const -> const_reference
+    {
+        return evaluate_element(std::make_index_sequence<sizeof...(CT)>(), index, positions);
+    }
+
+    template <class F, class R, class... CT>
+    template <class DM, std::size_t... I>
+    inline void xaxis_function<F, R, CT...>::resolve_positions_impl(std::index_sequence<I...>, const DM& dim_mapping, std::size_t* positions) const
+    {
+        using expander = int[];
+        (void)expander{ 0, (std::get<I>(m_e).resolve_positions(dim_mapping, positions + leaf_offset<I>::value), 0)... };
+    }
+
+    template <class F, class R, class... CT>
+    template <class Idx, std::size_t... I>
+    inline auto xaxis_function<F, R, CT...>::evaluate_element(std::index_sequence<I...>, const Idx& index, const std::size_t* positions) const -> const_reference
+    {
+        return m_f(std::get<I>(m_e).element(index, positions + leaf_offset<I>::value)...);
+    }
+
+    /**
+     * Evaluates the function once per label in \c tables if it depends on
+     * a single axis, or if it is a conjunction of such functions.
+     * @param tables the xaxis_mask_tables to fill.
+     * @param positions the positions filled by resolve_positions.
+     * @param shape the shape of the masked variable.
+     * @return false if the function is not separable.
+     */
+    template <class F, class R, class... CT>
+    template <class T, class S>
+    inline bool xaxis_function<F, R, CT...>::tabulate(T& tables, const std::size_t* positions, const S& shape) const
+    {
+        return tables.tabulate_single_axis(*this, positions, leaf_count, shape) ||
+            tabulate_impl(std::is_same<std::decay_t<functor_type>, xt::detail::logical_and>(),
+                          std::make_index_sequence<sizeof...(CT)>(), tables, positions, shape);
+    }
+
+    template <class F, class R, class... CT>
+    template <class T, class S, std::size_t... I>
+    inline bool xaxis_function<F, R, CT...>::tabulate_impl(std::true_type, std::index_sequence<I...>, T& tables, const std::size_t* positions, const S& shape) const
+    {
+        bool res = true;
+        using expander = int[];
+        (void)expander{ 0, (res = res && std::get<I>(m_e).tabulate(tables, positions + leaf_offset<I>::value, shape), 0)... };
+        return res;
+    }
+
+    template <class F, class R, class... CT>
+    template <class T, class S, std::size_t... I>
+    inline bool xaxis_function<F, R, CT...>::tabulate_impl(std::false_type, std::index_sequence<I...>, T&, const std::size_t*, const S&) const
+    {
+        return false;
+    }
+
+    /*********************
+     * xaxis_mask_tables *
+     *********************/
+
+    namespace detail
+    {
+        // Evaluation of a separable boolean axis expression, i.e. depending
+        // on a single axis or a conjunction of such expressions: it holds
+        // at an index if each table holds at the index along its axis. An
+        // empty table holds everywhere.
+        class xaxis_mask_tables
+        {
+        public:
+
+            using table_type = std::vector<std::uint8_t>;
+
+            xaxis_mask_tables() = default;
+
+            template <class E, class S>
+            xaxis_mask_tables(const E& e, const std::size_t* positions, const S& shape);
+
+            bool separable() const noexcept;
+
+            template <class I>
+            bool contains(const I& index) const noexcept;
+
+            std::vector<std::size_t> selected(std::size_t axis, std::size_t size) const;
+
+            template <class E, class S>
+            bool tabulate_single_axis(const E& e, const std::size_t* positions, std::size_t leaf_count, const S& shape);
+
+        private:
+
+            template <class E, class S>
+            bool tabulate(const E& e, const std::size_t* positions, const S& shape, std::true_type);
+
+            template <class E, class S>
+            bool tabulate(const E& e, const std::size_t* positions, const S& shape, std::false_type);
+
+            std::vector<table_type> m_tables;
+            bool m_separable = false;
+        };
+
+        template <class E, class S>
+        inline xaxis_mask_tables::xaxis_mask_tables(const E& e, const std::size_t* positions, const S& shape)
+            : m_tables(shape.size())
+        {
+            using value_type = std::decay_t<decltype(e.element(std::vector<std::size_t>(), positions))>;
+            m_separable = shape.size() != 0 && tabulate(e, positions, shape, std::is_same<value_type, bool>());
+            if (!m_separable)
+            {
+                m_tables.clear();
+            }
+        }
+
+        inline bool xaxis_mask_tables::separable() const noexcept
+        {
+            return m_separable;
+        }
+
+        template <class I>
+        inline bool xaxis_mask_tables::contains(const I& index) const noexcept
+        {
+            for (std::size_t axis = 0; axis < m_tables.size(); ++axis)
+            {
+                if (!m_tables[axis].empty() && !m_tables[axis][static_cast<std::size_t>(index[axis])])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Returns the positions along axis where the tables hold.
+        inline std::vector<std::size_t> xaxis_mask_tables::selected(std::size_t axis, std::size_t size) const
+        {
+            std::vector<std::size_t> res;
+            if (m_tables[axis].empty())
+            {
+                res.resize(size);
+                std::iota(res.begin(), res.end(), std::size_t(0));
+            }
+            else
+            {
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    if (m_tables[axis][i])
+                    {
+                        res.push_back(i);
+                    }
+                }
+            }
+            return res;
+        }
+
+        template <class E, class S>
+        inline bool xaxis_mask_tables::tabulate_single_axis(const E& e, const std::size_t* positions, std::size_t leaf_count, const S& shape)
+        {
+            std::size_t axis = leaf_count == 0 ? 0 : positions[0];
+            for (std::size_t i = 1; i < leaf_count; ++i)
+            {
+                if (positions[i] != axis)
+                {
+                    return false;
+                }
+            }
+
+            std::size_t size = static_cast<std::size_t>(shape[axis]);
+            table_type& table = m_tables[axis];
+            if (table.empty())
+            {
+                table.assign(size, std::uint8_t(1));
+            }
+            std::vector<std::size_t> index(shape.size(), std::size_t(0));
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                index[axis] = i;
+                table[i] = table[i] && static_cast<bool>(e.element(index, positions));
+            }
+            return true;
+        }
+
+        template <class E, class S>
+        inline bool xaxis_mask_tables::tabulate(const E& e, const std::size_t* positions, const S& shape, std::true_type)
+        {
+            return e.tabulate(*this, positions, shape);
+        }
+
+        template <class E, class S>
+        inline bool xaxis_mask_tables::tabulate(const E&, const std::size_t*, const S&, std::false_type)
+        {
+            return false;
+        }
+    }
+
     /**********************
      * axis_function_mask *
      **********************/
 
     namespace detail
     {
+        // The axis function is resolved against the dimension mapping once,
+        // each element then only loads its labels from the index, or one
+        // boolean per axis if the function is separable.
         template <class AF, class DM>
         class axis_function_mask_impl
         {
@@ -143,61 +405,52 @@ namespace xf
             using name_type = typename axis_function_type::name_type;
             using size_type = typename axis_function_type::size_type;
 
-            template <std::size_t N = dynamic()>
-            using selector_sequence_type = detail::xselector_sequence_t<std::pair<name_type, size_type>, N>;
-
-            axis_function_mask_impl(AF&& axis_function, DM&& dim_mapping)
-                : m_axis_function(std::forward<AF>(axis_function)),
-                  m_dimension_mapping(std::forward<DM>(dim_mapping))
+            template <class S>
+            axis_function_mask_impl(AF&& axis_function, DM&& dim_mapping, const S& shape)
+                : m_axis_function(std::forward<AF>(axis_function))
             {
+                m_axis_function.resolve_positions(dim_mapping, m_positions.data());
+                m_tables = xaxis_mask_tables(m_axis_function, m_positions.data(), shape);
             }
 
             template <class... Args>
             inline value_type operator()(Args... args) const
             {
-                auto selector = make_selector(std::make_index_sequence<sizeof...(Args)>(), args...);
-#ifdef _MSC_VER
-                return m_axis_function.operator()<sizeof...(Args)>(selector);
-#else
-                return m_axis_function.template operator()<sizeof...(Args)>(selector);
-#endif
+                std::array<size_type, sizeof...(Args)> index = { static_cast<size_type>(args)... };
+                return evaluate(index);
             }
 
             template <class It>
-            inline value_type element(It first, It last) const
+            inline value_type element(It first, It /*last*/) const
             {
-                // TODO avoid dynamic allocation
-                auto selector = selector_sequence_type<dynamic()>();
-                std::size_t i = 0;
-                for (It it = first; it != last; ++it)
-                {
-                    selector.push_back(std::make_pair(m_dimension_mapping.label(i++), static_cast<size_type>(*it)));
-                }
-#ifdef _MSC_VER
-                return m_axis_function.operator()<dynamic()>(selector);
-#else
-                return m_axis_function.template operator()<dynamic()>(selector);
-#endif
+                return evaluate(first);
             }
 
-        private:
+            const xaxis_mask_tables& tables() const noexcept
+            {
+                return m_tables;
+            }
 
-            AF m_axis_function;
-            DM m_dimension_mapping;
+        private:
 
-            template <class... Args, std::size_t... I>
-            inline selector_sequence_type<sizeof...(Args)> make_selector(std::index_sequence<I...>, Args&&... args) const
+            template <class I>
+            inline value_type evaluate(const I& index) const
             {
-                return {std::make_pair(m_dimension_mapping.label(I), static_cast<size_type>(args))...};
+                return m_tables.separable() ? value_type(m_tables.contains(index))
+                                            : m_axis_function.element(index, m_positions.data());
             }
+
+            AF m_axis_function;
+            std::array<std::size_t, axis_function_type::leaf_count> m_positions;
+            xaxis_mask_tables m_tables;
         };
     }
 
     template <class AF, class DM, class S>
-    inline auto axis_function_mask(AF&& axis_function, DM&& dim_mapping, const S& shape) noexcept
+    inline auto axis_function_mask(AF&& axis_function, DM&& dim_mapping, const S& shape)
     {
         return xt::detail::make_xgenerator(
-            detail::axis_function_mask_impl<AF, DM>(std::forward<AF>(axis_function), std::forward<DM>(dim_mapping)),
+            detail::axis_function_mask_impl<AF, DM>(std::forward<AF>(axis_function), std::forward<DM>(dim_mapping), shape),
             shape
         );
     }
@@ -11,7 +11,10 @@
 #ifndef XFRAME_XAXIS_LABEL_SLICE_HPP
 #define XFRAME_XAXIS_LABEL_SLICE_HPP
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
+#include <type_traits>
 #include <xtl/xvariant.hpp>
 #include "xaxis_index_slice.hpp"
 #include "xframe_config.hpp"
@@ -79,6 +82,94 @@ namespace xf
         size_type m_step;
     };
 
+    /*****************
+     * xaxis_between *
+     *****************/
+
+    /**
+     * @class xaxis_between
+     * @brief Slice selecting the labels of a sorted axis that belong to
+     * a closed interval.
+     *
+     * Contrary to xaxis_range, the bounds of the interval do not need to be
+     * labels of the axis. The slice is computed with two binary searches.
+     *
+     * @tparam L the type list of labels.
+     */
+    template <class L>
+    class xaxis_between
+    {
+    public:
+
+        using value_type = xlabel_variant_t<L>;
+
+        xaxis_between(const value_type& first, const value_type& last) noexcept;
+        xaxis_between(value_type&& first, value_type&& last) noexcept;
+
+        template <class A>
+        using index_slice_type = xt::xrange<typename A::mapped_type>;
+
+        template <class A>
+        index_slice_type<A> build_index_slice(const A& axis) const;
+
+    private:
+
+        value_type m_first;
+        value_type m_last;
+    };
+
+    /****************
+     * xaxis_search *
+     ****************/
+
+    /**
+     * Search strategies of xaxis_search.
+     */
+    enum class search_mode
+    {
+        /// last label less than or equal to the searched label.
+        backward,
+        /// first label greater than or equal to the searched label.
+        forward,
+        /// label closest to the searched label.
+        nearest
+    };
+
+    /**
+     * @class xaxis_search
+     * @brief Slice selecting the label of a sorted axis matching a label
+     * that may not belong to the axis.
+     *
+     * The slice holds a single element and keeps the dimension in the
+     * resulting view. If no label matches, an exception is thrown.
+     *
+     * @tparam L the type list of labels.
+     */
+    template <class L>
+    class xaxis_search
+    {
+    public:
+
+        using value_type = xlabel_variant_t<L>;
+
+        xaxis_search(const value_type& label, search_mode mode) noexcept;
+        xaxis_search(value_type&& label, search_mode mode) noexcept;
+
+        template <class A>
+        using index_slice_type = xt::xrange<typename A::mapped_type>;
+
+        template <class A>
+        index_slice_type<A> build_index_slice(const A& axis) const;
+
+    private:
+
+        template <class A>
+        typename A::size_type nearest_index(const A& axis) const;
+
+        value_type m_label;
+        search_mode m_mode;
+    };
+
     /*************
      * xaxis_all *
      *************/
@@ -206,6 +297,8 @@ namespace xf
         using squeeze_type = xlabel_variant_t<L>;
         using storage_type = xtl::variant<xaxis_range<L>,
                                           xaxis_stepped_range<L>,
+                                          xaxis_between<L>,
+                                          xaxis_search<L>,
                                           xaxis_keep_slice<L>,
                                           xaxis_drop_slice<L>,
                                           xaxis_all,
@@ -242,6 +335,18 @@ namespace xf
     template <class S, class L = XFRAME_DEFAULT_LABEL_LIST>
     xaxis_slice<L> range(xlabel_variant_t<L>&& first, xlabel_variant_t<L>&& last, S step);
 
+    template <class L = XFRAME_DEFAULT_LABEL_LIST>
+    xaxis_slice<L> between(const xlabel_variant_t<L>& first, const xlabel_variant_t<L>& last);
+
+    template <class L = XFRAME_DEFAULT_LABEL_LIST>
+    xaxis_slice<L> asof_backward(const xlabel_variant_t<L>& label);
+
+    template <class L = XFRAME_DEFAULT_LABEL_LIST>
+    xaxis_slice<L> asof_forward(const xlabel_variant_t<L>& label);
+
+    template <class L = XFRAME_DEFAULT_LABEL_LIST>
+    xaxis_slice<L> nearest(const xlabel_variant_t<L>& label);
+
     xaxis_all all() noexcept;
 
     namespace detail
@@ -328,6 +433,125 @@ namespace xf
         return index_slice_type<A>(axis[m_first], axis[m_last] + 1, m_step);
     }
 
+    /********************************
+     * xaxis_between implementation *
+     ********************************/
+
+    template <class V>
+    inline xaxis_between<V>::xaxis_between(const value_type& first, const value_type& last) noexcept
+        : m_first(first), m_last(last)
+    {
+    }
+
+    template <class V>
+    inline xaxis_between<V>::xaxis_between(value_type&& first, value_type&& last) noexcept
+        : m_first(std::move(first)), m_last(std::move(last))
+    {
+    }
+
+    template <class V>
+    template <class A>
+    inline auto xaxis_between<V>::build_index_slice(const A& axis) const -> index_slice_type<A>
+    {
+        using mapped_type = typename A::mapped_type;
+        auto first = axis.lower_bound_index(m_first);
+        auto last = std::max(first, axis.upper_bound_index(m_last));
+        return index_slice_type<A>(static_cast<mapped_type>(first), static_cast<mapped_type>(last));
+    }
+
+    /*******************************
+     * xaxis_search implementation *
+     *******************************/
+
+    template <class V>
+    inline xaxis_search<V>::xaxis_search(const value_type& label, search_mode mode) noexcept
+        : m_label(label), m_mode(mode)
+    {
+    }
+
+    template <class V>
+    inline xaxis_search<V>::xaxis_search(value_type&& label, search_mode mode) noexcept
+        : m_label(std::move(label)), m_mode(mode)
+    {
+    }
+
+    template <class V>
+    template <class A>
+    inline auto xaxis_search<V>::build_index_slice(const A& axis) const -> index_slice_type<A>
+    {
+        using mapped_type = typename A::mapped_type;
+        using size_type = typename A::size_type;
+        size_type index = 0;
+        switch (m_mode)
+        {
+        case search_mode::backward:
+            index = axis.upper_bound_index(m_label);
+            if (index == size_type(0))
+            {
+                throw std::out_of_range("asof_backward: no label before the searched label");
+            }
+            --index;
+            break;
+        case search_mode::forward:
+            index = axis.lower_bound_index(m_label);
+            if (index == axis.size())
+            {
+                throw std::out_of_range("asof_forward: no label after the searched label");
+            }
+            break;
+        case search_mode::nearest:
+            index = nearest_index(axis);
+            break;
+        }
+        return index_slice_type<A>(static_cast<mapped_type>(index), static_cast<mapped_type>(index + 1));
+    }
+
+    namespace detail
+    {
+        // Returns true if prev is closer to key than next; prev <= key <= next.
+        template <class T>
+        inline std::enable_if_t<std::is_arithmetic<T>::value, bool>
+        is_closer(const T& prev, const T& next, const T& key)
+        {
+            return !(next - key < key - prev);
+        }
+
+        template <class T>
+        inline std::enable_if_t<!std::is_arithmetic<T>::value, bool>
+        is_closer(const T&, const T&, const T&)
+        {
+            throw std::runtime_error("nearest forbidden for non arithmetic labels");
+        }
+    }
+
+    template <class V>
+    template <class A>
+    inline auto xaxis_search<V>::nearest_index(const A& axis) const -> typename A::size_type
+    {
+        using size_type = typename A::size_type;
+        if (axis.empty())
+        {
+            throw std::out_of_range("nearest: empty axis");
+        }
+        size_type next = axis.lower_bound_index(m_label);
+        if (next == size_type(0))
+        {
+            return next;
+        }
+        if (next == axis.size())
+        {
+            return next - 1;
+        }
+        auto prev_label = axis.label(next - 1);
+        auto next_label = axis.label(next);
+        bool prev_is_closer = xtl::visit([&prev_label, &next_label](const auto& key)
+        {
+            using type = std::decay_t<decltype(key)>;
+            return detail::is_closer(xtl::get<type>(prev_label), xtl::get<type>(next_label), key);
+        }, m_label);
+        return prev_is_closer ? next - 1 : next;
+    }
+
     /****************************
      * xaxis_all implementation *
      ****************************/
@@ -460,6 +684,52 @@ namespace xf
         return xaxis_slice<L>(xaxis_stepped_range<L>(std::move(first), std::move(last), step));
     }
 
+    /**
+     * Returns a slice selecting the labels of a sorted axis that are
+     * in the closed interval [first, last]. The bounds do not need to
+     * be labels of the axis.
+     * @param first the lower bound of the interval.
+     * @param last the upper bound of the interval.
+     */
+    template <class L>
+    inline xaxis_slice<L> between(const xlabel_variant_t<L>& first, const xlabel_variant_t<L>& last)
+    {
+        return xaxis_slice<L>(xaxis_between<L>(first, last));
+    }
+
+    /**
+     * Returns a slice selecting the last label of a sorted axis that
+     * is less than or equal to \c label.
+     * @param label the label to search for.
+     */
+    template <class L>
+    inline xaxis_slice<L> asof_backward(const xlabel_variant_t<L>& label)
+    {
+        return xaxis_slice<L>(xaxis_search<L>(label, search_mode::backward));
+    }
+
+    /**
+     * Returns a slice selecting the first label of a sorted axis that
+     * is greater than or equal to \c label.
+     * @param label the label to search for.
+     */
+    template <class L>
+    inline xaxis_slice<L> asof_forward(const xlabel_variant_t<L>& label)
+    {
+        return xaxis_slice<L>(xaxis_search<L>(label, search_mode::forward));
+    }
+
+    /**
+     * Returns a slice selecting the label of a sorted axis that is the
+     * closest to \c label. Ties are resolved in favor of the lowest label.
+     * @param label the label to search for.
+     */
+    template <class L>
+    inline xaxis_slice<L> nearest(const xlabel_variant_t<L>& label)
+    {
+        return xaxis_slice<L>(xaxis_search<L>(label, search_mode::nearest));
+    }
+
     namespace detail
     {
         template <template <class> class R, class L, class T>
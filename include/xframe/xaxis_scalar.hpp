@@ -49,9 +49,20 @@ namespace xf
 
         xaxis_scalar(const xt::xscalar<CT>& v) noexcept;
 
+        static constexpr std::size_t leaf_count = 0;
+
         template <std::size_t N = dynamic(), class S>
         const_reference operator()(S&& /*selector*/) const;
 
+        template <class DM>
+        void resolve_positions(const DM& /*dim_mapping*/, std::size_t* /*positions*/) const noexcept;
+
+        template <class I>
+        const_reference element(const I& /*index*/, const std::size_t* /*positions*/) const;
+
+        template <class T, class S>
+        bool tabulate(T& tables, const std::size_t* positions, const S& shape) const;
+
     private:
 
         data_type m_data;
@@ -73,6 +84,26 @@ namespace xf
     {
         return m_data;
     }
+
+    template <class CT>
+    template <class DM>
+    inline void xaxis_scalar<CT>::resolve_positions(const DM& /*dim_mapping*/, std::size_t* /*positions*/) const noexcept
+    {
+    }
+
+    template <class CT>
+    template <class I>
+    inline auto xaxis_scalar<CT>::element(const I& /*index*/, const std::size_t* /*positions*/) const -> const_reference
+    {
+        return m_data;
+    }
+
+    template <class CT>
+    template <class T, class S>
+    inline bool xaxis_scalar<CT>::tabulate(T& tables, const std::size_t* positions, const S& shape) const
+    {
+        return tables.tabulate_single_axis(*this, positions, leaf_count, shape);
+    }
 }
 
 #endif
@@ -12,6 +12,8 @@
 #define XFRAME_XAXIS_VARIANT_HPP
 
 #include <functional>
+#include <stdexcept>
+#include <type_traits>
 #include "xtl/xclosure.hpp"
 #include "xtl/xmeta_utils.hpp"
 #include "xtl/xvariant.hpp"
@@ -66,6 +68,7 @@ namespace xf
             using storage_type = add_default_axis_t<tmp_storage_type, S, L...>;
             using label_list = xvector_variant_cref<std::vector<L>...>;
             using key_type = xtl::variant<typename xaxis<L, S, MT>::key_type...>;
+            using lookup_key_type = xtl::variant<lookup_type_t<typename xaxis<L, S, MT>::key_type>...>;
             using key_reference = xtl::variant<xtl::xclosure_wrapper<const typename xaxis<L, S, MT>::key_type&>...>;
             using mapped_type = S;
             using value_type = std::pair<key_type, mapped_type>;
@@ -82,6 +85,56 @@ namespace xf
     template <class L, class T, class MT>
     class xaxis_variant_iterator;
 
+    namespace detail
+    {
+        // The list of labels of an xaxis_variant is returned by reference,
+        // default axes do not store theirs.
+        template <class A>
+        inline const typename A::label_list& axis_variant_labels(const A& axis)
+        {
+            return axis.labels();
+        }
+
+        template <class K, class T>
+        inline const std::vector<K>& axis_variant_labels(const xaxis_default<K, T>&)
+        {
+            throw std::logic_error("xaxis_variant: default axes do not store their labels, use label or get_labels");
+        }
+
+        // Converts between the label variant of an axis and the variant of
+        // its lookup keys; the alternatives of both convert to each other.
+
+        template <class V>
+        inline const V& label_variant_cast_impl(const V& v, std::true_type) noexcept
+        {
+            return v;
+        }
+
+        template <class V, class W>
+        inline V label_variant_cast_impl(const W& w, std::false_type)
+        {
+            return xtl::visit([](const auto& arg) { return V(arg); }, w);
+        }
+
+        template <class V, class W>
+        inline decltype(auto) label_variant_cast(const W& w)
+        {
+            return label_variant_cast_impl<V>(w, std::is_same<V, W>());
+        }
+
+        // Builds the label searched for from a key of another type, through
+        // the lookup keys so that no label is registered.
+        template <class K, class LK, class S>
+        inline K axis_variant_key(const S& key)
+        {
+            return label_variant_cast<K>(LK(key));
+        }
+
+        template <class S, class K, class LK>
+        using enable_axis_lookup_t = std::enable_if_t<!std::is_same<std::decay_t<S>, K>::value &&
+                                                      std::is_constructible<LK, const S&>::value>;
+    }
+
     /*****************
      * xaxis_variant *
      *****************/
@@ -113,6 +166,7 @@ namespace xf
         using traits_type = detail::xaxis_variant_traits<T, MT, L>;
         using storage_type = typename traits_type::storage_type;
         using key_type = typename traits_type::key_type;
+        using lookup_key_type = typename traits_type::lookup_key_type;
         using key_reference = typename traits_type::key_reference;
         using mapped_type = T;
         using label_list = typename traits_type::label_list;
@@ -150,6 +204,11 @@ namespace xf
         bool contains(const key_type& key) const;
         mapped_type operator[](const key_type& key) const;
 
+        template <class S, class = detail::enable_axis_lookup_t<S, key_type, lookup_key_type>>
+        bool contains(const S& key) const;
+        template <class S, class = detail::enable_axis_lookup_t<S, key_type, lookup_key_type>>
+        mapped_type operator[](const S& key) const;
+
         template <class F>
         self_type filter(const F& f) const;
 
@@ -158,6 +217,12 @@ namespace xf
 
         const_iterator find(const key_type& key) const;
 
+        template <class S, class = detail::enable_axis_lookup_t<S, key_type, lookup_key_type>>
+        const_iterator find(const S& key) const;
+
+        size_type lower_bound_index(const key_type& key) const;
+        size_type upper_bound_index(const key_type& key) const;
+
         const_iterator begin() const;
         const_iterator end() const;
 
@@ -176,13 +241,22 @@ namespace xf
         template <class... Args>
         bool intersect(const Args&... axes);
 
+        bool shares_labels(const self_type& rhs) const;
+
         self_type as_xaxis() const;
 
+        const storage_type& storage() const noexcept;
+
         bool operator==(const self_type& rhs) const;
         bool operator!=(const self_type& rhs) const;
 
     private:
 
+        bool is_default() const noexcept;
+
+        template <class... Args>
+        bool has_same_type(const Args&... axes) const noexcept;
+
         storage_type m_data;
 
         template <class OS, class L1, class T1, class MT1>
@@ -314,12 +388,15 @@ namespace xf
      */
     //@{
     /**
-     * Returns the list of labels contained in the axis.
+     * Returns the list of labels contained in the axis. Default axes
+     * do not store their labels, use \c label, the iterators or
+     * \c get_labels instead.
+     * @throw std::logic_error if the axis is a default axis.
      */
     template <class L, class T, class MT>
     inline auto xaxis_variant<L, T, MT>::labels() const -> label_list
     {
-        return xtl::visit([](auto&& arg) -> label_list { return arg.labels(); }, m_data);
+        return xtl::visit([](const auto& arg) -> label_list { return detail::axis_variant_labels(arg); }, m_data);
     };
 
     /**
@@ -329,7 +406,7 @@ namespace xf
     template <class L, class T, class MT>
     inline auto xaxis_variant<L, T, MT>::label(size_type i) const -> key_type
     {
-        return xtl::visit([i](auto&& arg) -> key_type { return arg.labels()[i]; }, m_data);
+        return xtl::visit([i](auto&& arg) -> key_type { return arg.label(i); }, m_data);
     }
 
     /**
@@ -394,6 +471,32 @@ namespace xf
         };
         return xtl::visit(lambda, m_data);
     }
+
+    /**
+     * Returns true if the axis contains the label equivalent to \c key,
+     * converted to a label without being registered as one. Selectors
+     * hold such keys, see xinterned_string_key.
+     * @param key the label to search for.
+     */
+    template <class L, class T, class MT>
+    template <class S, class>
+    inline bool xaxis_variant<L, T, MT>::contains(const S& key) const
+    {
+        return contains(detail::axis_variant_key<key_type, lookup_key_type>(key));
+    }
+
+    /**
+     * Returns the position of the label equivalent to \c key, converted
+     * to a label without being registered as one. If this last one is
+     * not found, an exception is thrown.
+     * @param key the label to search for.
+     */
+    template <class L, class T, class MT>
+    template <class S, class>
+    inline auto xaxis_variant<L, T, MT>::operator[](const S& key) const -> mapped_type
+    {
+        return operator[](detail::axis_variant_key<key_type, lookup_key_type>(key));
+    }
     //@}
 
     /**
@@ -446,6 +549,53 @@ namespace xf
         return xtl::visit(lambda, m_data);
     }
 
+    /**
+     * Returns a constant iterator to the element with label equivalent to \c key,
+     * converted to a label without being registered as one. If no such element
+     * is found, past-the-end iterator is returned.
+     * @param key the label to search for.
+     */
+    template <class L, class T, class MT>
+    template <class S, class>
+    inline auto xaxis_variant<L, T, MT>::find(const S& key) const -> const_iterator
+    {
+        return find(detail::axis_variant_key<key_type, lookup_key_type>(key));
+    }
+
+    /**
+     * Returns the position of the first label that is not less than \c key,
+     * or the size of the axis if there is no such label. The axis must be
+     * sorted.
+     * @param key the label to search for.
+     */
+    template <class L, class T, class MT>
+    inline auto xaxis_variant<L, T, MT>::lower_bound_index(const key_type& key) const -> size_type
+    {
+        auto lambda = [&key](auto&& arg) -> size_type
+        {
+            using type = typename std::decay_t<decltype(arg)>::key_type;
+            return arg.lower_bound_index(xtl::get<type>(key));
+        };
+        return xtl::visit(lambda, m_data);
+    }
+
+    /**
+     * Returns the position of the first label that is greater than \c key,
+     * or the size of the axis if there is no such label. The axis must be
+     * sorted.
+     * @param key the label to search for.
+     */
+    template <class L, class T, class MT>
+    inline auto xaxis_variant<L, T, MT>::upper_bound_index(const key_type& key) const -> size_type
+    {
+        auto lambda = [&key](auto&& arg) -> size_type
+        {
+            using type = typename std::decay_t<decltype(arg)>::key_type;
+            return arg.upper_bound_index(xtl::get<type>(key));
+        };
+        return xtl::visit(lambda, m_data);
+    }
+
     /**
      * Returns a constant iterator to the first element of the axis.
      * This element is a pair label - position.
@@ -527,22 +677,47 @@ namespace xf
     }
     //@}
 
+    namespace detail
+    {
+        // Labels of an axis held by an xaxis_variant, seen through the
+        // label type K of the axis they are merged into. The labels of
+        // a default axis are computed, never built.
+
+        template <class K, class T, class MT>
+        inline xaxis_label_range<K> axis_label_range(const xaxis<K, T, MT>& axis)
+        {
+            return xaxis_label_range<K>(axis.labels());
+        }
+
+        template <class K, class T>
+        inline xaxis_label_range<K> axis_label_range(const xaxis_default<K, T>& axis)
+        {
+            return xaxis_label_range<K>(axis.size());
+        }
+
+        template <class K, class A>
+        inline xaxis_label_range<K> axis_label_range(const A&)
+        {
+            throw std::invalid_argument("xaxis_variant: label types of the axes do not match");
+        }
+    }
+
     template <class L, class T, class MT, class K>
     struct xaxis_variant_adaptor
     {
         using axis_variant_type = xaxis_variant<L, T, MT>;
         using key_type = K;
         using axis_type =  xaxis<K, T, MT>;
-        using label_list = typename axis_type::label_list;
+        using label_list = detail::xaxis_label_range<K>;
 
         xaxis_variant_adaptor(const axis_variant_type& axis)
             : m_axis(axis)
         {
         };
 
-        inline const label_list& labels() const
+        inline label_list labels() const
         {
-            return xget_vector<std::vector<key_type>>(m_axis.labels());
+            return xtl::visit([](const auto& arg) { return detail::axis_label_range<K>(arg); }, m_axis.storage());
         };
 
         inline bool is_sorted() const noexcept
@@ -555,13 +730,90 @@ namespace xf
         const axis_variant_type& m_axis;
     };
 
+    namespace detail
+    {
+        template <class L, class T, class MT>
+        struct xaxis_variant_set_operation
+        {
+            using axis_variant_type = xaxis_variant<L, T, MT>;
+
+            template <class A, class... Args>
+            static bool merge(A& axis, const Args&... axes)
+            {
+                using key_type = typename A::key_type;
+                return axis.merge(xaxis_variant_adaptor<L, T, MT, key_type>(axes)...);
+            }
+
+            template <class LB, class... Args>
+            static bool merge(xaxis_default<LB, T>& axis, const Args&... axes)
+            {
+                return axis.merge(xaxis_default<LB, T>(axes.size())...);
+            }
+
+            template <class A, class... Args>
+            static bool intersect(A& axis, const Args&... axes)
+            {
+                using key_type = typename A::key_type;
+                return axis.intersect(xaxis_variant_adaptor<L, T, MT, key_type>(axes)...);
+            }
+
+            template <class LB, class... Args>
+            static bool intersect(xaxis_default<LB, T>& axis, const Args&... axes)
+            {
+                return axis.intersect(xaxis_default<LB, T>(axes.size())...);
+            }
+        };
+
+        // Axes built as copies of each other share their labels. Default
+        // axes of the same size and label type hold the same labels.
+
+        template <class LB, class T, class MT>
+        inline bool axis_shares_labels(const xaxis<LB, T, MT>& lhs, const xaxis<LB, T, MT>& rhs) noexcept
+        {
+            return &(lhs.labels()) == &(rhs.labels());
+        }
+
+        template <class LB, class T>
+        inline bool axis_shares_labels(const xaxis_default<LB, T>& lhs, const xaxis_default<LB, T>& rhs) noexcept
+        {
+            return lhs.size() == rhs.size();
+        }
+
+        struct xaxis_variant_equal
+        {
+            template <class A1, class A2>
+            bool operator()(const A1& lhs, const A2& rhs) const
+            {
+                using key_type1 = typename A1::key_type;
+                using key_type2 = typename A2::key_type;
+                return compare(lhs, rhs, std::is_same<key_type1, key_type2>());
+            }
+
+        private:
+
+            template <class A1, class A2>
+            static bool compare(const A1& lhs, const A2& rhs, std::true_type)
+            {
+                return lhs == rhs;
+            }
+
+            template <class A1, class A2>
+            static bool compare(const A1&, const A2&, std::false_type)
+            {
+                return false;
+            }
+        };
+    }
+
     /**
      * @name Set operations
      */
     //@{
     /**
      * Merges all the axes arguments into this ones. After this function call,
-     * the axis contains all the labels from all the arguments.
+     * the axis contains all the labels from all the arguments. If this axis
+     * and all the arguments are default axes, the result is still a default
+     * axis; otherwise this axis is converted to an xaxis first.
      * @param axes the axes to merge.
      * @return true is the axis already contained all the labels.
      */
@@ -569,17 +821,21 @@ namespace xf
     template <class... Args>
     inline bool xaxis_variant<L, T, MT>::merge(const Args&... axes)
     {
+        if (is_default() && !has_same_type(axes...))
+        {
+            *this = as_xaxis();
+        }
         auto lambda = [&axes...](auto&& arg) -> bool
         {
-            using key_type = typename std::decay_t<decltype(arg)>::key_type;
-            return arg.merge(xaxis_variant_adaptor<L, T, MT, key_type>(axes)...);
+            return detail::xaxis_variant_set_operation<L, T, MT>::merge(arg, axes...);
         };
         return xtl::visit(lambda, m_data);
     }
 
     /**
      * Replaces the labels with the intersection of the labels of
-     * the axes arguments and the labels of this axis.
+     * the axes arguments and the labels of this axis. As for \c merge,
+     * the result is a default axis if all the axes are default axes.
      * @param axes the axes to intersect.
      * @return true if the intersection is equivalent to this axis.
      */
@@ -587,13 +843,41 @@ namespace xf
     template <class... Args>
     inline bool xaxis_variant<L, T, MT>::intersect(const Args&... axes)
     {
+        if (is_default() && !has_same_type(axes...))
+        {
+            *this = as_xaxis();
+        }
         auto lambda = [&axes...](auto&& arg) -> bool
         {
-            using key_type = typename std::decay_t<decltype(arg)>::key_type;
-            return arg.intersect(xaxis_variant_adaptor<L, T, MT, key_type>(axes)...);
+            return detail::xaxis_variant_set_operation<L, T, MT>::intersect(arg, axes...);
         };
         return xtl::visit(lambda, m_data);
     }
+
+    /**
+     * Returns true if this axis and \c rhs are known to hold the same
+     * labels without comparing them, i.e. if they are copies of the same
+     * axis, or default axes of the same size. This check does not depend
+     * on the number of labels.
+     * @param rhs the axis to compare with.
+     */
+    template <class L, class T, class MT>
+    inline bool xaxis_variant<L, T, MT>::shares_labels(const self_type& rhs) const
+    {
+        if (this == &rhs)
+        {
+            return true;
+        }
+        if (m_data.index() != rhs.m_data.index())
+        {
+            return false;
+        }
+        return xtl::visit([&rhs](const auto& arg)
+        {
+            using axis_type = std::decay_t<decltype(arg)>;
+            return detail::axis_shares_labels(arg, xtl::get<axis_type>(rhs.m_data));
+        }, m_data);
+    }
     //@}
 
     template <class L, class T, class MT>
@@ -602,6 +886,33 @@ namespace xf
         return xtl::visit([](auto&& arg) { return self_type(xaxis<typename std::decay_t<decltype(arg)>::key_type, T, MT>(arg)); }, m_data);
     }
 
+    /**
+     * Returns the variant of typed axes held by the xaxis_variant.
+     */
+    template <class L, class T, class MT>
+    inline auto xaxis_variant<L, T, MT>::storage() const noexcept -> const storage_type&
+    {
+        return m_data;
+    }
+
+    template <class L, class T, class MT>
+    inline bool xaxis_variant<L, T, MT>::is_default() const noexcept
+    {
+        return xtl::visit([](auto&& arg) { return is_axis_default<std::decay_t<decltype(arg)>>::value; }, m_data);
+    }
+
+    template <class L, class T, class MT>
+    template <class... Args>
+    inline bool xaxis_variant<L, T, MT>::has_same_type(const Args&... axes) const noexcept
+    {
+        bool res = true;
+        for (std::size_t index : std::initializer_list<std::size_t>{ axes.m_data.index()... })
+        {
+            res &= (index == m_data.index());
+        }
+        return res;
+    }
+
     /**
      * Returns true is this axis and \c rhs are equivalent axes, i.e. they contain the same
      * label - position pairs.
@@ -610,7 +921,7 @@ namespace xf
     template <class L, class T, class MT>
     inline bool xaxis_variant<L, T, MT>::operator==(const self_type& rhs) const
     {
-        return m_data == rhs.m_data;
+        return xtl::visit(detail::xaxis_variant_equal(), m_data, rhs.m_data);
     }
 
     /**
@@ -621,7 +932,7 @@ namespace xf
     template <class L, class T, class MT>
     inline bool xaxis_variant<L, T, MT>::operator!=(const self_type& rhs) const
     {
-        return m_data != rhs.m_data;
+        return !(*this == rhs);
     }
 
     template <class OS, class L, class T, class MT>
@@ -728,11 +1039,15 @@ namespace xf
         return lhs.less_than(rhs);
     }
 
+    /**
+     * Returns a random access range over the labels of type \c LB of the
+     * axis. The labels of a default axis are computed, not stored.
+     * @throw std::invalid_argument if the labels of the axis are not of type \c LB.
+     */
     template <class LB, class L, class T, class MT>
-    auto get_labels(const xaxis_variant<L, T, MT>& axis_variant) -> const typename xaxis<LB, T, MT>::label_list&
+    auto get_labels(const xaxis_variant<L, T, MT>& axis_variant) -> detail::xaxis_label_range<LB>
     {
-        using label_list = typename xaxis<LB, T, MT>::label_list;
-        return xtl::xget<const label_list&>(axis_variant.labels().storage());
+        return xtl::visit([](const auto& arg) { return detail::axis_label_range<LB>(arg); }, axis_variant.storage());
     }
 }
 
@@ -52,6 +52,7 @@ namespace xf
         using slice_type = xaxis_index_slice<T>;
 
         using key_type = typename axis_type::key_type;
+        using lookup_key_type = typename axis_type::lookup_key_type;
         using mapped_type = typename axis_type::mapped_type;
         using value_type = typename axis_type::value_type;
         using reference = typename axis_type::const_reference;
@@ -83,6 +84,11 @@ namespace xf
         mapped_type operator[](const key_type& key) const;
         mapped_type index(size_type label_index) const;
 
+        template <class S, class = detail::enable_axis_lookup_t<S, key_type, lookup_key_type>>
+        bool contains(const S& key) const;
+        template <class S, class = detail::enable_axis_lookup_t<S, key_type, lookup_key_type>>
+        mapped_type operator[](const S& key) const;
+
         template <class F>
         axis_type filter(const F& f) const;
 
@@ -292,6 +298,31 @@ namespace xf
         }
     }
 
+    /**
+     * Returns true if the view contains the label equivalent to \c key,
+     * converted to a label without being registered as one.
+     * @param key the label to search for.
+     */
+    template <class L, class T, class MT>
+    template <class S, class>
+    inline bool xaxis_view<L, T, MT>::contains(const S& key) const
+    {
+        return contains(detail::axis_variant_key<key_type, lookup_key_type>(key));
+    }
+
+    /**
+     * Returns the position of the label equivalent to \c key in the
+     * underlying axis, converted to a label without being registered as
+     * one. If this last one is not found, an exception is thrown.
+     * @param key the label to search for.
+     */
+    template <class L, class T, class MT>
+    template <class S, class>
+    inline auto xaxis_view<L, T, MT>::operator[](const S& key) const -> mapped_type
+    {
+        return operator[](detail::axis_variant_key<key_type, lookup_key_type>(key));
+    }
+
     /**
      * Get the label mapped to the specified position in the view, and returns
      * it position in the underlying axis.
@@ -438,6 +469,28 @@ namespace xf
         return m_axis.as_xaxis();
     }
 
+    namespace detail
+    {
+        // Compares the labels one by one, so that views on default axes
+        // do not build their list of labels.
+        template <class A1, class A2>
+        inline bool axis_view_equal(const A1& lhs, const A2& rhs)
+        {
+            if (lhs.size() != rhs.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < lhs.size(); ++i)
+            {
+                if (!(lhs.label(i) == rhs.label(i)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
     /**
      * Returns true is \c lhs and \c d rhs are equivalent axes, i.e. they contain the same
      * label - position pairs.
@@ -447,7 +500,7 @@ namespace xf
     template <class L, class T, class MT>
     inline bool operator==(const xaxis_view<L, T, MT>& lhs, const xaxis_view<L, T, MT>& rhs) noexcept
     {
-        return lhs.labels() == rhs.labels();
+        return detail::axis_view_equal(lhs, rhs);
     }
 
     /**
@@ -471,7 +524,7 @@ namespace xf
     template <class L, class T, class MT>
     inline bool operator==(const xaxis_view<L, T, MT>& lhs, const xaxis_variant<L, T, MT>& rhs) noexcept
     {
-        return lhs.labels() == rhs.labels();
+        return detail::axis_view_equal(lhs, rhs);
     }
 
     /**
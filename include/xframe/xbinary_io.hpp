@@ -0,0 +1,749 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XFRAME_XBINARY_IO_HPP
+#define XFRAME_XBINARY_IO_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define XFRAME_HAS_MMAP 1
+#else
+#define XFRAME_HAS_MMAP 0
+#endif
+
+#include "xtensor/xadapt.hpp"
+#include "xtensor/xoptional_assembly.hpp"
+
+#include "xvariable.hpp"
+
+namespace xf
+{
+    /**
+     * @defgroup binary_io Binary I/O
+     *
+     * Variables are saved in a versioned binary format made of three
+     * sections:
+     * - a header, holding the names of the dimensions in their order,
+     *   and the labels of each axis;
+     * - the values, in row-major order, aligned on 64 bytes;
+     * - the missing mask, one byte per value, aligned on 64 bytes.
+     *
+     * Values and labels are written in the byte order of the machine;
+     * loading a file written with another byte order fails. Values must
+     * be arithmetic; labels can be arithmetic or strings.
+     */
+
+    template <class CCT, class ECT>
+    void save(const xvariable_container<CCT, ECT>& v, const std::string& path);
+
+    template <class V>
+    V load(const std::string& path);
+
+    template <class T, class CCT>
+    class xmapped_variable;
+
+    template <class T, class CCT = xcoordinate<fstring>>
+    xmapped_variable<T, CCT> load_mapped(const std::string& path);
+
+    namespace detail
+    {
+        /******************
+         * binary formats *
+         ******************/
+
+        constexpr char binary_magic[8] = { 'X', 'F', 'R', 'A', 'M', 'E', 'B', '\0' };
+        constexpr std::uint32_t binary_version = 1;
+        constexpr std::uint32_t binary_byte_order = 0x01020304;
+        constexpr std::size_t binary_alignment = 64;
+
+        // Fixed-size part of the file, at offset 0.
+        struct xbinary_header
+        {
+            char m_magic[8];
+            std::uint32_t m_version;
+            std::uint32_t m_byte_order;
+            std::uint64_t m_values_offset;
+            std::uint64_t m_mask_offset;
+            std::uint64_t m_size;
+            std::uint8_t m_value_kind;
+            std::uint8_t m_value_size;
+            std::uint8_t m_padding[6];
+        };
+
+        // Kind and size of the values and labels written in a file.
+        template <class T, class = void>
+        struct xbinary_type
+        {
+            static constexpr std::uint8_t kind = 's';
+            static constexpr std::uint8_t size = 0;
+        };
+
+        template <class T>
+        struct xbinary_type<T, std::enable_if_t<std::is_arithmetic<T>::value>>
+        {
+            static constexpr std::uint8_t kind = std::is_same<T, bool>::value ? 'b'
+                : std::is_same<T, char>::value ? 'c'
+                : std::is_floating_point<T>::value ? 'f'
+                : std::is_signed<T>::value ? 'i' : 'u';
+            static constexpr std::uint8_t size = static_cast<std::uint8_t>(sizeof(T));
+        };
+
+        template <class T>
+        inline bool is_binary_type(std::uint8_t kind, std::uint8_t size) noexcept
+        {
+            return kind == xbinary_type<T>::kind && size == xbinary_type<T>::size;
+        }
+
+        inline std::size_t binary_align(std::size_t offset) noexcept
+        {
+            return (offset + binary_alignment - 1) / binary_alignment * binary_alignment;
+        }
+
+        /******************
+         * xbinary_writer *
+         ******************/
+
+        // Serializes the header of a file in a buffer.
+        class xbinary_writer
+        {
+        public:
+
+            const std::string& buffer() const noexcept
+            {
+                return m_buffer;
+            }
+
+            template <class T>
+            void write(const T& value)
+            {
+                write(value, std::is_arithmetic<T>());
+            }
+
+        private:
+
+            template <class T>
+            void write(const T& value, std::true_type)
+            {
+                m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            template <class T>
+            void write(const T& value, std::false_type)
+            {
+                std::uint64_t size = static_cast<std::uint64_t>(value.size());
+                write(size, std::true_type());
+                m_buffer.append(value.c_str(), value.size());
+            }
+
+            std::string m_buffer;
+        };
+
+        /******************
+         * xbinary_reader *
+         ******************/
+
+        // Deserializes the header of a file from a buffer.
+        class xbinary_reader
+        {
+        public:
+
+            xbinary_reader(const char* first, const char* last) noexcept
+                : p_current(first), p_last(last)
+            {
+            }
+
+            template <class T>
+            T read()
+            {
+                return read<T>(std::is_arithmetic<T>());
+            }
+
+            std::size_t remaining() const noexcept
+            {
+                return static_cast<std::size_t>(p_last - p_current);
+            }
+
+        private:
+
+            template <class T>
+            T read(std::true_type)
+            {
+                check(sizeof(T));
+                T res;
+                std::memcpy(&res, p_current, sizeof(T));
+                p_current += sizeof(T);
+                return res;
+            }
+
+            template <class T>
+            T read(std::false_type)
+            {
+                std::size_t size = static_cast<std::size_t>(read<std::uint64_t>(std::true_type()));
+                check(size);
+                std::string tmp(p_current, size);
+                p_current += size;
+                return T(tmp.c_str());
+            }
+
+            void check(std::size_t size) const
+            {
+                if (static_cast<std::size_t>(p_last - p_current) < size)
+                {
+                    throw std::runtime_error("binary file: truncated header");
+                }
+            }
+
+            const char* p_current;
+            const char* p_last;
+        };
+
+        /****************
+         * axis writers *
+         ****************/
+
+        struct xbinary_axis_writer
+        {
+            template <class L, class T, class MT>
+            void operator()(const xaxis<L, T, MT>& axis) const
+            {
+                write_type<L>(false, axis.size());
+                for (const auto& label : axis.labels())
+                {
+                    p_writer->write(label);
+                }
+            }
+
+            template <class L, class T>
+            void operator()(const xaxis_default<L, T>& axis) const
+            {
+                write_type<L>(true, axis.size());
+            }
+
+            template <class L>
+            void write_type(bool is_default, std::size_t size) const
+            {
+                p_writer->write(static_cast<std::uint8_t>(xbinary_type<L>::kind));
+                p_writer->write(static_cast<std::uint8_t>(xbinary_type<L>::size));
+                p_writer->write(static_cast<std::uint8_t>(is_default));
+                p_writer->write(static_cast<std::uint64_t>(size));
+            }
+
+            xbinary_writer* p_writer;
+        };
+
+        /****************
+         * axis readers *
+         ****************/
+
+        // Builds the axis whose label type matches the kind and the size
+        // read from the file, among the label types of the coordinates.
+        template <class A, class TL>
+        struct xbinary_axis_reader;
+
+        template <class A, template <class...> class TL>
+        struct xbinary_axis_reader<A, TL<>>
+        {
+            static A read(xbinary_reader&, std::uint8_t, std::uint8_t, bool, std::size_t)
+            {
+                throw std::runtime_error("binary file: label type not supported by the coordinates");
+            }
+        };
+
+        template <class A, template <class...> class TL, class L1, class... L>
+        struct xbinary_axis_reader<A, TL<L1, L...>>
+        {
+            using mapped_type = typename A::mapped_type;
+            using map_tag = typename A::map_container_tag;
+
+            static A read(xbinary_reader& in, std::uint8_t kind, std::uint8_t size, bool is_default, std::size_t nb_labels)
+            {
+                if (is_binary_type<L1>(kind, size))
+                {
+                    return is_default ? read_default(nb_labels, std::is_integral<L1>()) : read_labels(in, nb_labels);
+                }
+                return xbinary_axis_reader<A, TL<L...>>::read(in, kind, size, is_default, nb_labels);
+            }
+
+        private:
+
+            static A read_labels(xbinary_reader& in, std::size_t nb_labels)
+            {
+                // Each label takes at least its size, or the size of its
+                // length for strings, in the header.
+                constexpr std::size_t min_label_size = std::is_arithmetic<L1>::value ? sizeof(L1) : sizeof(std::uint64_t);
+                if (nb_labels > in.remaining() / min_label_size)
+                {
+                    throw std::runtime_error("binary file: truncated header");
+                }
+                std::vector<L1> labels;
+                labels.reserve(nb_labels);
+                for (std::size_t i = 0; i < nb_labels; ++i)
+                {
+                    labels.push_back(in.read<L1>());
+                }
+                return A(xaxis<L1, mapped_type, map_tag>(std::move(labels)));
+            }
+
+            static A read_default(std::size_t nb_labels, std::true_type)
+            {
+                return A(xaxis_default<L1, mapped_type>(nb_labels));
+            }
+
+            static A read_default(std::size_t, std::false_type)
+            {
+                throw std::runtime_error("binary file: default axis with non-integral labels");
+            }
+        };
+
+        /******************
+         * xbinary_layout *
+         ******************/
+
+        // Coordinates and sections of a file, read from its header.
+        template <class T, class CCT>
+        struct xbinary_layout
+        {
+            using coordinate_type = CCT;
+            using coordinate_map = typename coordinate_type::map_type;
+            using key_type = typename coordinate_type::key_type;
+            using axis_type = typename coordinate_type::axis_type;
+            using dimension_list = typename xdimension<key_type, typename coordinate_type::size_type>::label_list;
+
+            coordinate_map m_coordinates;
+            dimension_list m_dimensions;
+            std::vector<std::size_t> m_shape;
+            std::size_t m_size;
+            std::size_t m_values_offset;
+            std::size_t m_mask_offset;
+        };
+
+        // size is the number of bytes available at first, file_size the
+        // size of the whole file.
+        inline xbinary_header read_binary_header(const char* first, std::size_t size, std::size_t file_size)
+        {
+            xbinary_header header;
+            if (size < sizeof(xbinary_header))
+            {
+                throw std::runtime_error("binary file: truncated header");
+            }
+            std::memcpy(&header, first, sizeof(xbinary_header));
+            if (std::memcmp(header.m_magic, binary_magic, sizeof(binary_magic)) != 0)
+            {
+                throw std::runtime_error("binary file: not an xframe file");
+            }
+            if (header.m_version != binary_version)
+            {
+                throw std::runtime_error("binary file: unsupported version");
+            }
+            if (header.m_byte_order != binary_byte_order)
+            {
+                throw std::runtime_error("binary file: written with another byte order");
+            }
+            if (header.m_values_offset < sizeof(xbinary_header) || header.m_mask_offset < header.m_values_offset)
+            {
+                throw std::runtime_error("binary file: invalid header");
+            }
+            if (header.m_mask_offset > file_size)
+            {
+                throw std::runtime_error("binary file: truncated data");
+            }
+            return header;
+        }
+
+        // first points to the beginning of the file, last to the end of
+        // the header, i.e. at least to the beginning of the values. The
+        // number of elements must match the shape, and the values and the
+        // mask must fit in the file.
+        template <class T, class CCT>
+        inline xbinary_layout<T, CCT> read_binary_layout(const char* first, const char* last, std::size_t file_size)
+        {
+            using layout_type = xbinary_layout<T, CCT>;
+            using key_type = typename layout_type::key_type;
+            using axis_type = typename layout_type::axis_type;
+            using label_list = typename CCT::label_list;
+
+            xbinary_header header = read_binary_header(first, static_cast<std::size_t>(last - first), file_size);
+            if (!is_binary_type<T>(header.m_value_kind, header.m_value_size))
+            {
+                throw std::runtime_error("binary file: value type does not match");
+            }
+
+            layout_type res;
+            res.m_size = static_cast<std::size_t>(header.m_size);
+            res.m_values_offset = static_cast<std::size_t>(header.m_values_offset);
+            res.m_mask_offset = static_cast<std::size_t>(header.m_mask_offset);
+
+            xbinary_reader in(first + sizeof(xbinary_header), last);
+            std::size_t dimension = static_cast<std::size_t>(in.read<std::uint64_t>());
+            for (std::size_t d = 0; d < dimension; ++d)
+            {
+                key_type name = in.read<key_type>();
+                std::uint8_t kind = in.read<std::uint8_t>();
+                std::uint8_t size = in.read<std::uint8_t>();
+                bool is_default = in.read<std::uint8_t>() != 0;
+                std::size_t nb_labels = static_cast<std::size_t>(in.read<std::uint64_t>());
+                res.m_coordinates[name] = xbinary_axis_reader<axis_type, label_list>::read(in, kind, size, is_default, nb_labels);
+                res.m_dimensions.push_back(name);
+                res.m_shape.push_back(nb_labels);
+            }
+
+            // The product of the shape is only computed when it cannot be
+            // zero, so that an overflow is always an invalid size.
+            bool empty = std::find(res.m_shape.cbegin(), res.m_shape.cend(), std::size_t(0)) != res.m_shape.cend();
+            std::size_t size = empty ? std::size_t(0) : std::size_t(1);
+            for (std::size_t i = 0; !empty && i < res.m_shape.size(); ++i)
+            {
+                if (size > std::numeric_limits<std::size_t>::max() / res.m_shape[i])
+                {
+                    throw std::runtime_error("binary file: size does not match the shape");
+                }
+                size *= res.m_shape[i];
+            }
+            if (size != res.m_size)
+            {
+                throw std::runtime_error("binary file: size does not match the shape");
+            }
+            if (res.m_size > (res.m_mask_offset - res.m_values_offset) / sizeof(T) ||
+                res.m_size > file_size - res.m_mask_offset)
+            {
+                throw std::runtime_error("binary file: truncated data");
+            }
+            return res;
+        }
+
+        /****************
+         * xmapped_file *
+         ****************/
+
+        // Read-only file mapped in memory. Pages are mapped privately, so
+        // that writing to them does not modify the file.
+        class xmapped_file
+        {
+        public:
+
+            explicit xmapped_file(const std::string& path);
+            ~xmapped_file();
+
+            xmapped_file(const xmapped_file&) = delete;
+            xmapped_file& operator=(const xmapped_file&) = delete;
+            xmapped_file(xmapped_file&&) = delete;
+            xmapped_file& operator=(xmapped_file&&) = delete;
+
+            char* data() const noexcept;
+            std::size_t size() const noexcept;
+
+        private:
+
+            char* p_data;
+            std::size_t m_size;
+        };
+
+#if XFRAME_HAS_MMAP
+        inline xmapped_file::xmapped_file(const std::string& path)
+            : p_data(nullptr), m_size(0)
+        {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+            {
+                throw std::runtime_error("binary file: cannot open " + path);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) == -1)
+            {
+                ::close(fd);
+                throw std::runtime_error("binary file: cannot stat " + path);
+            }
+            m_size = static_cast<std::size_t>(st.st_size);
+            void* addr = m_size == 0 ? MAP_FAILED : ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (addr == MAP_FAILED)
+            {
+                throw std::runtime_error("binary file: cannot map " + path);
+            }
+            p_data = static_cast<char*>(addr);
+        }
+
+        inline xmapped_file::~xmapped_file()
+        {
+            ::munmap(p_data, m_size);
+        }
+#else
+        inline xmapped_file::xmapped_file(const std::string&)
+            : p_data(nullptr), m_size(0)
+        {
+            throw std::runtime_error("binary file: memory mapping is not supported on this platform");
+        }
+
+        inline xmapped_file::~xmapped_file()
+        {
+        }
+#endif
+
+        inline char* xmapped_file::data() const noexcept
+        {
+            return p_data;
+        }
+
+        inline std::size_t xmapped_file::size() const noexcept
+        {
+            return m_size;
+        }
+    }
+
+    /********************
+     * xmapped_variable *
+     ********************/
+
+    /**
+     * @class xmapped_variable
+     * @brief Variable whose data is a file mapped in memory.
+     *
+     * The xmapped_variable owns the mapping of a file written by \c save,
+     * and a variable adapting the values and the missing mask of the file
+     * without copying them. The missing mask is validated when the file
+     * is opened, the pages of the values are loaded on first access.
+     * Modifying the variable does not modify the file.
+     *
+     * @tparam T the value type of the variable.
+     * @tparam CCT the coordinate type of the variable.
+     * @ingroup binary_io
+     * @sa load_mapped
+     */
+    template <class T, class CCT>
+    class xmapped_variable
+    {
+    public:
+
+        using shape_type = std::vector<std::size_t>;
+        using value_adaptor = decltype(xt::adapt(std::declval<T*>(), std::size_t(0), xt::no_ownership(),
+                                                 std::declval<const shape_type&>()));
+        using mask_adaptor = decltype(xt::adapt(std::declval<bool*>(), std::size_t(0), xt::no_ownership(),
+                                                std::declval<const shape_type&>()));
+        using data_type = xt::xoptional_assembly_adaptor<value_adaptor, mask_adaptor>;
+        using variable_type = xvariable_container<CCT, data_type>;
+
+        explicit xmapped_variable(const std::string& path);
+
+        variable_type& variable() noexcept;
+        const variable_type& variable() const noexcept;
+
+    private:
+
+        static variable_type make_variable(detail::xmapped_file& file);
+
+        std::unique_ptr<detail::xmapped_file> p_file;
+        variable_type m_variable;
+    };
+
+    /***********************************
+     * xmapped_variable implementation *
+     ***********************************/
+
+    /**
+     * Maps the specified file in memory.
+     * @throw std::runtime_error if the file cannot be mapped, or if it is
+     * not a valid file for this variable type.
+     */
+    template <class T, class CCT>
+    inline xmapped_variable<T, CCT>::xmapped_variable(const std::string& path)
+        : p_file(new detail::xmapped_file(path)), m_variable(make_variable(*p_file))
+    {
+    }
+
+    /**
+     * Returns the variable adapting the mapped file.
+     */
+    template <class T, class CCT>
+    inline auto xmapped_variable<T, CCT>::variable() noexcept -> variable_type&
+    {
+        return m_variable;
+    }
+
+    /**
+     * Returns the variable adapting the mapped file.
+     */
+    template <class T, class CCT>
+    inline auto xmapped_variable<T, CCT>::variable() const noexcept -> const variable_type&
+    {
+        return m_variable;
+    }
+
+    template <class T, class CCT>
+    inline auto xmapped_variable<T, CCT>::make_variable(detail::xmapped_file& file) -> variable_type
+    {
+        char* first = file.data();
+        std::size_t file_size = file.size();
+        auto layout = detail::read_binary_layout<T, CCT>(first, first + file_size, file_size);
+        // The mapping is page-aligned, save aligns the values on 64 bytes.
+        if (layout.m_values_offset % alignof(T) != 0)
+        {
+            throw std::runtime_error("binary file: misaligned values");
+        }
+        // The mask is written with one byte of value 0 or 1 per element;
+        // any other byte would not be a valid bool.
+        static_assert(sizeof(bool) == 1, "mapped masks require one-byte bool");
+        const unsigned char* mask_bytes = reinterpret_cast<const unsigned char*>(first + layout.m_mask_offset);
+        if (!std::all_of(mask_bytes, mask_bytes + layout.m_size, [](unsigned char c) { return c <= 1; }))
+        {
+            throw std::runtime_error("binary file: invalid missing mask");
+        }
+        T* values = reinterpret_cast<T*>(first + layout.m_values_offset);
+        bool* mask = reinterpret_cast<bool*>(first + layout.m_mask_offset);
+        data_type data(xt::adapt(values, layout.m_size, xt::no_ownership(), layout.m_shape),
+                       xt::adapt(mask, layout.m_size, xt::no_ownership(), layout.m_shape));
+        return variable_type(std::move(data), std::move(layout.m_coordinates), std::move(layout.m_dimensions));
+    }
+
+    /*****************************
+     * binary I/O implementation *
+     *****************************/
+
+    /**
+     * @ingroup binary_io
+     * Saves the specified variable in a binary file.
+     * @param v the variable to save; its values must be arithmetic and
+     * stored in row-major order.
+     * @param path the path of the file.
+     * @throw std::runtime_error if the file cannot be written.
+     */
+    template <class CCT, class ECT>
+    inline void save(const xvariable_container<CCT, ECT>& v, const std::string& path)
+    {
+        using value_type = typename std::decay_t<decltype(v.data().value())>::value_type;
+        static_assert(std::is_arithmetic<value_type>::value, "binary files hold arithmetic values only");
+        if (v.data().value().layout() != xt::layout_type::row_major)
+        {
+            throw std::runtime_error("binary file: row-major data required");
+        }
+
+        detail::xbinary_writer meta;
+        const auto& dims = v.dimension_labels();
+        meta.write(static_cast<std::uint64_t>(dims.size()));
+        for (const auto& name : dims)
+        {
+            meta.write(name);
+            xtl::visit(detail::xbinary_axis_writer{ &meta }, v.coordinates()[name].storage());
+        }
+
+        std::size_t size = v.data().size();
+        detail::xbinary_header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.m_magic, detail::binary_magic, sizeof(header.m_magic));
+        header.m_version = detail::binary_version;
+        header.m_byte_order = detail::binary_byte_order;
+        header.m_values_offset = detail::binary_align(sizeof(header) + meta.buffer().size());
+        header.m_mask_offset = detail::binary_align(header.m_values_offset + size * sizeof(value_type));
+        header.m_size = size;
+        header.m_value_kind = detail::xbinary_type<value_type>::kind;
+        header.m_value_size = detail::xbinary_type<value_type>::size;
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            throw std::runtime_error("binary file: cannot open " + path);
+        }
+        const char padding[detail::binary_alignment] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(meta.buffer().data(), static_cast<std::streamsize>(meta.buffer().size()));
+        out.write(padding, static_cast<std::streamsize>(header.m_values_offset - sizeof(header) - meta.buffer().size()));
+        out.write(reinterpret_cast<const char*>(v.data().value().data()), static_cast<std::streamsize>(size * sizeof(value_type)));
+        out.write(padding, static_cast<std::streamsize>(header.m_mask_offset - header.m_values_offset - size * sizeof(value_type)));
+
+        const auto& mask = v.data().has_value().storage();
+        std::vector<char> bytes(size);
+        std::transform(mask.cbegin(), mask.cend(), bytes.begin(), [](bool b) { return static_cast<char>(b); });
+        out.write(bytes.data(), static_cast<std::streamsize>(size));
+        if (!out)
+        {
+            throw std::runtime_error("binary file: cannot write " + path);
+        }
+    }
+
+    /**
+     * @ingroup binary_io
+     * Loads a variable from a binary file written by \c save. The values
+     * are read in a single block, without parsing.
+     * @tparam V the type of the variable, e.g. \c xvariable<double, xcoordinate<fstring>>.
+     * @param path the path of the file.
+     * @throw std::runtime_error if the file cannot be read, or if it does
+     * not match the value or label types of \c V.
+     */
+    template <class V>
+    inline V load(const std::string& path)
+    {
+        using value_type = typename std::decay_t<decltype(std::declval<V&>().data().value())>::value_type;
+        using coordinate_type = typename V::coordinate_type;
+
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+        {
+            throw std::runtime_error("binary file: cannot open " + path);
+        }
+        std::size_t file_size = static_cast<std::size_t>(in.tellg());
+        in.seekg(0);
+        detail::xbinary_header header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        detail::read_binary_header(reinterpret_cast<const char*>(&header), static_cast<std::size_t>(in.gcount()), file_size);
+
+        std::string meta(static_cast<std::size_t>(header.m_values_offset), '\0');
+        std::memcpy(&meta[0], &header, sizeof(header));
+        in.read(&meta[sizeof(header)], static_cast<std::streamsize>(meta.size() - sizeof(header)));
+        auto layout = detail::read_binary_layout<value_type, coordinate_type>(meta.data(), meta.data() + meta.size(), file_size);
+
+        V res(std::move(layout.m_coordinates), std::move(layout.m_dimensions));
+        in.read(reinterpret_cast<char*>(res.data().value().data()), static_cast<std::streamsize>(layout.m_size * sizeof(value_type)));
+        in.seekg(static_cast<std::streamoff>(layout.m_mask_offset));
+        std::vector<char> bytes(layout.m_size);
+        in.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!in)
+        {
+            throw std::runtime_error("binary file: truncated data");
+        }
+        auto& mask = res.data().has_value().storage();
+        std::transform(bytes.cbegin(), bytes.cend(), mask.begin(), [](char c) { return c != 0; });
+        return res;
+    }
+
+    /**
+     * @ingroup binary_io
+     * Maps a binary file written by \c save in memory. Opening the file
+     * reads its header and its missing mask, the values are loaded on
+     * first access.
+     * @tparam T the value type of the variable.
+     * @tparam CCT the coordinate type of the variable.
+     * @param path the path of the file.
+     * @throw std::runtime_error if the file cannot be mapped, or if it does
+     * not match the value or label types, or if its values are misaligned
+     * or its missing mask holds bytes other than 0 and 1.
+     */
+    template <class T, class CCT>
+    inline xmapped_variable<T, CCT> load_mapped(const std::string& path)
+    {
+        return xmapped_variable<T, CCT>(path);
+    }
+}
+
+#endif
@@ -0,0 +1,154 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XFRAME_XBITSET_MASK_HPP
+#define XFRAME_XBITSET_MASK_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "xtl/xdynamic_bitset.hpp"
+
+#include "xtensor/xarray.hpp"
+#include "xtensor/xoptional_assembly.hpp"
+
+namespace xf
+{
+    /****************
+     * xbitset_mask *
+     ****************/
+
+    /**
+     * Missing mask storing one bit per element, in blocks of 64 bits.
+     */
+    using xbitset_mask_block = std::uint64_t;
+    using xbitset_mask = xt::xarray_container<xtl::xdynamic_bitset<xbitset_mask_block>>;
+
+    /**
+     * Optional container whose missing mask is bit-packed. It can be used
+     * as the data container of a variable, or as the default one by
+     * defining \c XFRAME_ENABLE_BITSET_MASK to 1 before including xframe.
+     */
+    template <class T>
+    using xbitset_optional = xt::xoptional_assembly<xt::xarray<T>, xbitset_mask>;
+
+    /**
+     * Metafunction returning true if the optional container \c D stores
+     * its missing mask in an xbitset_mask.
+     */
+    template <class D>
+    struct has_bitset_mask
+        : std::is_same<std::decay_t<decltype(std::declval<const D&>().has_value())>, xbitset_mask>
+    {
+    };
+
+    template <class M>
+    bool all_valid(const M& mask);
+
+    bool all_valid(const xbitset_mask& mask);
+
+    /*******************************
+     * xbitset_mask implementation *
+     *******************************/
+
+    /**
+     * Returns true if the specified mask holds no missing value.
+     */
+    template <class M>
+    inline bool all_valid(const M& mask)
+    {
+        return std::all_of(mask.cbegin(), mask.cend(), [](bool b) { return b; });
+    }
+
+    /**
+     * Returns true if the specified mask holds no missing value. The mask
+     * is checked one block of 64 elements at a time.
+     */
+    inline bool all_valid(const xbitset_mask& mask)
+    {
+        return mask.storage().all();
+    }
+
+    namespace detail
+    {
+        // Cursors give the reduction kernels an indexed access to a row of
+        // a mask: a raw pointer for masks of bool, one bit per element for
+        // bitset masks, and a constant for masks known to be all valid.
+
+        class xbitset_cursor
+        {
+        public:
+
+            xbitset_cursor(const xbitset_mask_block* blocks, std::size_t offset) noexcept
+                : p_blocks(blocks), m_offset(offset)
+            {
+            }
+
+            bool operator[](std::size_t i) const noexcept
+            {
+                std::size_t pos = m_offset + i;
+                return (p_blocks[pos / block_bits] >> (pos % block_bits)) & xbitset_mask_block(1);
+            }
+
+            xbitset_cursor operator+(std::size_t i) const noexcept
+            {
+                return xbitset_cursor(p_blocks, m_offset + i);
+            }
+
+        private:
+
+            static constexpr std::size_t block_bits = 8 * sizeof(xbitset_mask_block);
+
+            const xbitset_mask_block* p_blocks;
+            std::size_t m_offset;
+        };
+
+        struct xall_valid_cursor
+        {
+            constexpr bool operator[](std::size_t) const noexcept
+            {
+                return true;
+            }
+
+            constexpr xall_valid_cursor operator+(std::size_t) const noexcept
+            {
+                return *this;
+            }
+        };
+
+        // Calls f with a cursor on the specified mask.
+        template <class M, class F>
+        inline void with_mask_cursor(const M& mask, F&& f)
+        {
+            const bool* cursor = mask.data();
+            f(cursor);
+        }
+
+        // Bitset masks without missing value are detected with a single
+        // pass over the blocks, the kernels then skip the mask entirely.
+        template <class F>
+        inline void with_mask_cursor(const xbitset_mask& mask, F&& f)
+        {
+            if (all_valid(mask))
+            {
+                f(xall_valid_cursor());
+            }
+            else
+            {
+                f(xbitset_cursor(mask.storage().data(), std::size_t(0)));
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,301 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XFRAME_XBROADCAST_PLAN_HPP
+#define XFRAME_XBROADCAST_PLAN_HPP
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "xtl/xtype_traits.hpp"
+
+#include "xvariable_meta.hpp"
+#include "xvariable_scalar.hpp"
+
+namespace xf
+{
+    template <class CCT, class ECT>
+    class xvariable_container;
+
+    template <class F, class R, class... CT>
+    class xvariable_function;
+
+    /*******************
+     * xbroadcast_plan *
+     *******************/
+
+    /**
+     * @class xbroadcast_plan
+     * @brief Precomputed translation of output positions into positions of
+     * the leaves of an expression.
+     *
+     * When the coordinates of an expression differ from the ones of the
+     * variable it is assigned to, each output element would require a label
+     * lookup per dimension in every leaf of the expression. The xbroadcast_plan
+     * resolves these lookups once per label: for each dimension of each leaf,
+     * it holds an array mapping output positions to positions in the leaf, or
+     * \c -1 if the label is missing in the leaf. Accessing an element of the
+     * expression then only involves integer loads.
+     *
+     * The remapping tables are immutable and shared between the copies of
+     * a plan; a copy only owns the scratch index of each leaf, so that
+     * threads assigning different chunks can each work on their own copy.
+     *
+     * @tparam E the type of the expression.
+     * @sa has_broadcast_plan
+     */
+    template <class E>
+    class xbroadcast_plan;
+
+    /**
+     * Metafunction returning true if an xbroadcast_plan can be built
+     * for the expression type \c E.
+     */
+    template <class E>
+    struct has_broadcast_plan : std::false_type
+    {
+    };
+
+    template <class CCT, class ECT>
+    struct has_broadcast_plan<xvariable_container<CCT, ECT>> : std::true_type
+    {
+    };
+
+    template <class CT>
+    struct has_broadcast_plan<xvariable_scalar<CT>> : std::true_type
+    {
+    };
+
+    template <class F, class R, class... CT>
+    struct has_broadcast_plan<xvariable_function<F, R, CT...>>
+        : xtl::conjunction<has_broadcast_plan<xdecay_variable_closure_t<CT>>...>
+    {
+    };
+
+    namespace detail
+    {
+        using position_remap = std::vector<std::ptrdiff_t>;
+
+        template <class S>
+        struct xbroadcast_tables
+        {
+            std::vector<position_remap> m_remap;
+            std::vector<S> m_output_position;
+        };
+
+        template <class AO, class AI>
+        inline position_remap build_position_remap(const AO& output, const AI& input)
+        {
+            position_remap res(output.size());
+            for (std::size_t i = 0; i < res.size(); ++i)
+            {
+                auto label = output.label(i);
+                res[i] = input.contains(label) ? static_cast<std::ptrdiff_t>(input[label]) : std::ptrdiff_t(-1);
+            }
+            return res;
+        }
+
+        template <class A>
+        inline position_remap build_position_remap(const A& output, const A& input)
+        {
+            if (output == input)
+            {
+                position_remap res(output.size());
+                for (std::size_t i = 0; i < res.size(); ++i)
+                {
+                    res[i] = static_cast<std::ptrdiff_t>(i);
+                }
+                return res;
+            }
+            return build_position_remap<A, A>(output, input);
+        }
+    }
+
+    template <class CCT, class ECT>
+    class xbroadcast_plan<xvariable_container<CCT, ECT>>
+    {
+    public:
+
+        using expression_type = xvariable_container<CCT, ECT>;
+        using const_reference = typename expression_type::const_reference;
+        using size_type = typename expression_type::size_type;
+
+        template <class C, class DM>
+        xbroadcast_plan(const expression_type& e, const C& coords, const DM& dims);
+
+        template <class Idx>
+        const_reference element(const Idx& index) const;
+
+    private:
+
+        using tables_type = detail::xbroadcast_tables<size_type>;
+
+        const expression_type& m_e;
+        std::shared_ptr<const tables_type> p_tables;
+        mutable std::vector<size_type> m_index;
+    };
+
+    template <class CT>
+    class xbroadcast_plan<xvariable_scalar<CT>>
+    {
+    public:
+
+        using expression_type = xvariable_scalar<CT>;
+        using const_reference = typename expression_type::const_reference;
+
+        template <class C, class DM>
+        xbroadcast_plan(const expression_type& e, const C& coords, const DM& dims);
+
+        template <class Idx>
+        const_reference element(const Idx& index) const;
+
+    private:
+
+        const expression_type& m_e;
+    };
+
+    template <class F, class R, class... CT>
+    class xbroadcast_plan<xvariable_function<F, R, CT...>>
+    {
+    public:
+
+        using expression_type = xvariable_function<F, R, CT...>;
+        using const_reference = typename expression_type::const_reference;
+
+        template <class C, class DM>
+        xbroadcast_plan(const expression_type& e, const C& coords, const DM& dims);
+
+        template <class Idx>
+        const_reference element(const Idx& index) const;
+
+    private:
+
+        template <std::size_t... I, class C, class DM>
+        xbroadcast_plan(std::index_sequence<I...>, const expression_type& e, const C& coords, const DM& dims);
+
+        template <std::size_t... I, class Idx>
+        const_reference element_impl(std::index_sequence<I...>, const Idx& index) const;
+
+        const expression_type& m_e;
+        std::tuple<xbroadcast_plan<xdecay_variable_closure_t<CT>>...> m_plans;
+    };
+
+    /**********************************
+     * xbroadcast_plan implementation *
+     **********************************/
+
+    /**
+     * Builds the plan of the variable \c e for the specified output
+     * coordinates and dimension mapping.
+     * @param e the variable to build the plan for.
+     * @param coords the coordinates of the assigned variable.
+     * @param dims the dimension mapping of the assigned variable.
+     */
+    template <class CCT, class ECT>
+    template <class C, class DM>
+    inline xbroadcast_plan<xvariable_container<CCT, ECT>>::xbroadcast_plan(const expression_type& e,
+                                                                          const C& coords,
+                                                                          const DM& dims)
+        : m_e(e), p_tables(), m_index()
+    {
+        const auto& labels = e.dimension_labels();
+        auto tables = std::make_shared<tables_type>();
+        tables->m_remap.reserve(labels.size());
+        tables->m_output_position.reserve(labels.size());
+        m_index.resize(labels.size());
+        for (const auto& name : labels)
+        {
+            tables->m_output_position.push_back(static_cast<size_type>(dims[name]));
+            tables->m_remap.push_back(detail::build_position_remap(coords[name], e.coordinates()[name]));
+        }
+        p_tables = std::move(tables);
+    }
+
+    /**
+     * Returns the element of the variable corresponding to the specified
+     * position in the output. If a label of the output is not present
+     * in the variable, the missing value is returned.
+     * @param index the position in the output.
+     */
+    template <class CCT, class ECT>
+    template <class Idx>
+    inline auto xbroadcast_plan<xvariable_container<CCT, ECT>>::element(const Idx& index) const -> const_reference
+    {
+        const auto& remap = p_tables->m_remap;
+        const auto& output_position = p_tables->m_output_position;
+        for (size_type i = 0; i < m_index.size(); ++i)
+        {
+            std::ptrdiff_t pos = remap[i][index[output_position[i]]];
+            if (pos < 0)
+            {
+                return expression_type::missing();
+            }
+            m_index[i] = static_cast<size_type>(pos);
+        }
+        return m_e.data().element(m_index.cbegin(), m_index.cend());
+    }
+
+    template <class CT>
+    template <class C, class DM>
+    inline xbroadcast_plan<xvariable_scalar<CT>>::xbroadcast_plan(const expression_type& e,
+                                                                 const C& /*coords*/,
+                                                                 const DM& /*dims*/)
+        : m_e(e)
+    {
+    }
+
+    template <class CT>
+    template <class Idx>
+    inline auto xbroadcast_plan<xvariable_scalar<CT>>::element(const Idx& index) const -> const_reference
+    {
+        return m_e.select(index);
+    }
+
+    template <class F, class R, class... CT>
+    template <class C, class DM>
+    inline xbroadcast_plan<xvariable_function<F, R, CT...>>::xbroadcast_plan(const expression_type& e,
+                                                                            const C& coords,
+                                                                            const DM& dims)
+        : xbroadcast_plan(std::make_index_sequence<sizeof...(CT)>(), e, coords, dims)
+    {
+    }
+
+    template <class F, class R, class... CT>
+    template <class Idx>
+    inline auto xbroadcast_plan<xvariable_function<F, R, CT...>>::element(const Idx& index) const -> const_reference
+    {
+        return element_impl(std::make_index_sequence<sizeof...(CT)>(), index);
+    }
+
+    template <class F, class R, class... CT>
+    template <std::size_t... I, class C, class DM>
+    inline xbroadcast_plan<xvariable_function<F, R, CT...>>::xbroadcast_plan(std::index_sequence<I...>,
+                                                                            const expression_type& e,
+                                                                            const C& coords,
+                                                                            const DM& dims)
+        : m_e(e),
+          m_plans(xbroadcast_plan<xdecay_variable_closure_t<CT>>(std::get<I>(e.arguments()), coords, dims)...)
+    {
+    }
+
+    template <class F, class R, class... CT>
+    template <std::size_t... I, class Idx>
+    inline auto xbroadcast_plan<xvariable_function<F, R, CT...>>::element_impl(std::index_sequence<I...>,
+                                                                              const Idx& index) const -> const_reference
+    {
+        return m_e.functor()(std::get<I>(m_plans).element(index)...);
+    }
+}
+
+#endif
@@ -0,0 +1,319 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XFRAME_XCOMPILED_LOCATOR_HPP
+#define XFRAME_XCOMPILED_LOCATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "xaxis.hpp"
+#include "xaxis_default.hpp"
+#include "xaxis_variant.hpp"
+
+namespace xf
+{
+    namespace detail
+    {
+        /***********************
+         * xlocator_axis_cache *
+         ***********************/
+
+        // Typed reference to the axis of a single dimension. Axes stored as
+        // an xaxis are probed directly, xaxis_default axes only need their
+        // size since their labels are their positions.
+        template <class L, class T, class MT>
+        class xlocator_axis_cache
+        {
+        public:
+
+            using axis_type = xaxis<L, T, MT>;
+            using size_type = std::size_t;
+
+            explicit xlocator_axis_cache(const axis_type& axis) noexcept;
+            explicit xlocator_axis_cache(size_type size) noexcept;
+
+            size_type operator[](const L& label) const;
+            size_type find(const L& label) const;
+
+        private:
+
+            size_type default_position(const L& label, std::true_type) const;
+            size_type default_position(const L& label, std::false_type) const;
+            size_type default_find(const L& label, std::true_type) const;
+            size_type default_find(const L& label, std::false_type) const;
+
+            const axis_type* p_axis;
+            size_type m_size;
+        };
+
+        template <class L, class T, class MT>
+        struct xlocator_axis_builder
+        {
+            using result_type = xlocator_axis_cache<L, T, MT>;
+
+            result_type operator()(const xaxis<L, T, MT>& axis) const
+            {
+                return result_type(axis);
+            }
+
+            result_type operator()(const xaxis_default<L, T>& axis) const
+            {
+                return result_type(axis.size());
+            }
+
+            template <class A>
+            result_type operator()(const A&) const
+            {
+                throw std::invalid_argument("compiled locator: label type does not match the axis");
+            }
+        };
+
+        template <class L, class T, class MT>
+        inline xlocator_axis_cache<L, T, MT>::xlocator_axis_cache(const axis_type& axis) noexcept
+            : p_axis(&axis), m_size(axis.size())
+        {
+        }
+
+        template <class L, class T, class MT>
+        inline xlocator_axis_cache<L, T, MT>::xlocator_axis_cache(size_type size) noexcept
+            : p_axis(nullptr), m_size(size)
+        {
+        }
+
+        template <class L, class T, class MT>
+        inline auto xlocator_axis_cache<L, T, MT>::operator[](const L& label) const -> size_type
+        {
+            if (p_axis != nullptr)
+            {
+                return static_cast<size_type>((*p_axis)[label]);
+            }
+            return default_position(label, std::is_integral<L>());
+        }
+
+        // Returns the position of the label, or the size of the axis if the
+        // label is not found.
+        template <class L, class T, class MT>
+        inline auto xlocator_axis_cache<L, T, MT>::find(const L& label) const -> size_type
+        {
+            if (p_axis != nullptr)
+            {
+                return static_cast<size_type>(p_axis->find(label) - p_axis->cbegin());
+            }
+            return default_find(label, std::is_integral<L>());
+        }
+
+        template <class L, class T, class MT>
+        inline auto xlocator_axis_cache<L, T, MT>::default_find(const L& label, std::true_type) const -> size_type
+        {
+            return (L(0) <= label && static_cast<size_type>(label) < m_size) ? static_cast<size_type>(label) : m_size;
+        }
+
+        template <class L, class T, class MT>
+        inline auto xlocator_axis_cache<L, T, MT>::default_find(const L&, std::false_type) const -> size_type
+        {
+            return m_size;
+        }
+
+        template <class L, class T, class MT>
+        inline auto xlocator_axis_cache<L, T, MT>::default_position(const L& label, std::true_type) const -> size_type
+        {
+            if (!(L(0) <= label && static_cast<size_type>(label) < m_size))
+            {
+                throw std::out_of_range("xaxis_default: label not found");
+            }
+            return static_cast<size_type>(label);
+        }
+
+        template <class L, class T, class MT>
+        inline auto xlocator_axis_cache<L, T, MT>::default_position(const L&, std::false_type) const -> size_type
+        {
+            throw std::out_of_range("xaxis_default: label not found");
+        }
+
+        template <class L, class A>
+        struct xlocator_axis_cache_type;
+
+        template <class L, class LL, class T, class MT>
+        struct xlocator_axis_cache_type<L, xaxis_variant<LL, T, MT>>
+        {
+            using type = xlocator_axis_cache<L, T, MT>;
+        };
+
+        template <class L, class A>
+        using xlocator_axis_cache_t = typename xlocator_axis_cache_type<L, A>::type;
+    }
+
+    /*********************
+     * xcompiled_locator *
+     *********************/
+
+    /**
+     * @class xcompiled_locator
+     * @brief Accessor binding a variable to a fixed order of dimensions.
+     *
+     * The xcompiled_locator resolves the names of the dimensions and the
+     * typed axes of a variable once, at construction. Locating an element
+     * then costs a single lookup per dimension in the typed axis, without
+     * any dimension name lookup or variant dispatch.
+     *
+     * The locator holds references on the axes of the variable; it is
+     * invalidated by any operation that modifies the coordinates of the
+     * variable (resize, reshape, assignment of another variable).
+     *
+     * @tparam V the type of the variable, possibly const.
+     * @tparam L the label types of the bound dimensions, in the order
+     *           of the bound dimensions.
+     * @sa compile_locator
+     */
+    template <class V, class... L>
+    class xcompiled_locator
+    {
+    public:
+
+        using self_type = xcompiled_locator<V, L...>;
+        using variable_type = V;
+        using decay_variable_type = std::remove_const_t<V>;
+        using reference = std::conditional_t<std::is_const<V>::value,
+                                             typename decay_variable_type::const_reference,
+                                             typename decay_variable_type::reference>;
+        using const_reference = typename decay_variable_type::const_reference;
+        using key_type = typename decay_variable_type::key_type;
+        using axis_type = typename decay_variable_type::coordinate_type::axis_type;
+        using size_type = std::size_t;
+
+        static constexpr std::size_t static_dimension = sizeof...(L);
+        using index_type = std::array<size_type, static_dimension>;
+
+        template <class... K>
+        xcompiled_locator(V& variable, const K&... dims);
+
+        reference operator()(const L&... labels) const;
+        index_type index(const L&... labels) const;
+
+    private:
+
+        using axis_cache_type = std::tuple<detail::xlocator_axis_cache_t<L, axis_type>...>;
+
+        template <std::size_t... I>
+        index_type index_impl(std::index_sequence<I...>, const L&... labels) const;
+
+        template <class LB>
+        static detail::xlocator_axis_cache_t<LB, axis_type> build_axis_cache(const axis_type& axis);
+
+        V* p_variable;
+        axis_cache_type m_axes;
+        index_type m_position;
+    };
+
+    template <class... L, class V, class... K>
+    xcompiled_locator<V, L...> compile_locator(V& variable, const K&... dims);
+
+    /************************************
+     * xcompiled_locator implementation *
+     ************************************/
+
+    /**
+     * Builds a locator on the specified variable.
+     * @param variable the variable to bind.
+     * @param dims the names of the dimensions, in the order the labels will
+     * be passed to the locator. All the dimensions of the variable must be
+     * specified.
+     * @throw std::invalid_argument if the number of dimensions does not match
+     * the dimension of the variable, or if a label type does not match the
+     * type of the corresponding axis.
+     */
+    template <class V, class... L>
+    template <class... K>
+    inline xcompiled_locator<V, L...>::xcompiled_locator(V& variable, const K&... dims)
+        : p_variable(&variable),
+          m_axes(build_axis_cache<L>(variable.coordinates()[dims])...),
+          m_position{ { static_cast<size_type>(variable.dimension_mapping()[dims])... } }
+    {
+        static_assert(sizeof...(K) == sizeof...(L), "compiled locator requires one label type per dimension");
+        if (variable.dimension() != static_dimension)
+        {
+            throw std::invalid_argument("compiled locator requires all the dimensions of the variable");
+        }
+        for (size_type i = 0; i < m_position.size(); ++i)
+        {
+            for (size_type j = i + 1; j < m_position.size(); ++j)
+            {
+                if (m_position[i] == m_position[j])
+                {
+                    throw std::invalid_argument("compiled locator requires distinct dimensions");
+                }
+            }
+        }
+    }
+
+    /**
+     * Returns a reference to the element with the specified labels.
+     * @param labels the labels of the element, in the order of the bound
+     * dimensions.
+     * @throw std::out_of_range if a label is not found in its axis.
+     */
+    template <class V, class... L>
+    inline auto xcompiled_locator<V, L...>::operator()(const L&... labels) const -> reference
+    {
+        index_type idx = index(labels...);
+        return p_variable->data().element(idx.cbegin(), idx.cend());
+    }
+
+    /**
+     * Returns the positions of the specified labels, in the order of the
+     * dimensions of the variable.
+     * @param labels the labels of the element, in the order of the bound
+     * dimensions.
+     */
+    template <class V, class... L>
+    inline auto xcompiled_locator<V, L...>::index(const L&... labels) const -> index_type
+    {
+        return index_impl(std::make_index_sequence<sizeof...(L)>(), labels...);
+    }
+
+    template <class V, class... L>
+    template <std::size_t... I>
+    inline auto xcompiled_locator<V, L...>::index_impl(std::index_sequence<I...>, const L&... labels) const -> index_type
+    {
+        index_type res;
+        using swallow = int[];
+        (void)swallow{0, (res[m_position[I]] = std::get<I>(m_axes)[labels], 0)...};
+        return res;
+    }
+
+    template <class V, class... L>
+    template <class LB>
+    inline auto xcompiled_locator<V, L...>::build_axis_cache(const axis_type& axis)
+        -> detail::xlocator_axis_cache_t<LB, axis_type>
+    {
+        using builder_type = detail::xlocator_axis_builder<LB, typename axis_type::mapped_type, typename axis_type::map_container_tag>;
+        return xtl::visit(builder_type(), axis.storage());
+    }
+
+    /**
+     * Builds an xcompiled_locator on the specified variable.
+     * @tparam L the label types of the bound dimensions.
+     * @param variable the variable to bind.
+     * @param dims the names of the dimensions, in the order the labels will
+     * be passed to the locator.
+     */
+    template <class... L, class V, class... K>
+    inline xcompiled_locator<V, L...> compile_locator(V& variable, const K&... dims)
+    {
+        return xcompiled_locator<V, L...>(variable, dims...);
+    }
+}
+
+#endif
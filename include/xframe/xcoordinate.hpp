@@ -314,6 +314,8 @@ namespace xf
 
     namespace detail
     {
+        // Axes sharing their labels are left untouched, so that broadcasting
+        // coordinates copied from each other does not scan their labels.
         template <class Join>
         struct axis_broadcast;
 
@@ -323,7 +325,7 @@ namespace xf
             template <class A>
             static bool apply(A& output, const A& input)
             {
-                return output.merge(input);
+                return output.shares_labels(input) || output.merge(input);
             }
         };
 
@@ -333,7 +335,7 @@ namespace xf
             template <class A>
             static bool apply(A& output, const A& input)
             {
-                return output.intersect(input);
+                return output.shares_labels(input) || output.intersect(input);
             }
         };
     }
@@ -405,11 +407,9 @@ namespace xf
     template <class Join, class... Args>
     inline xtrivial_broadcast xcoordinate<K, L, S, MT>::broadcast_empty(const self_type& c, const Args&... coordinates)
     {
-        map_type& m = this->coordinate();
-        for (auto iter = c.data().cbegin(); iter != c.data().cend(); ++iter)
-        {
-            m.insert(std::make_pair(iter->first, mapped_type(iter->second.as_xaxis())));
-        }
+        // Axes are copied as is, so that default axes remain
+        // default axes instead of being expanded.
+        this->coordinate().insert(c.data().cbegin(), c.data().cend());
         return broadcast_impl<Join>(coordinates...);
     }
 
@@ -0,0 +1,637 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XFRAME_XCSV_READER_HPP
+#define XFRAME_XCSV_READER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "xbitset_mask.hpp"
+#include "xframe_config.hpp"
+#include "xthread_pool.hpp"
+#include "xvariable.hpp"
+
+namespace xf
+{
+    /****************
+     * xcsv_options *
+     ****************/
+
+    /**
+     * Options of read_csv.
+     */
+    struct xcsv_options
+    {
+        /// The character separating the fields of a line.
+        char m_separator = ',';
+        /// The number of bytes read from the file at once.
+        std::size_t m_chunk_size = std::size_t(1) << 24;
+    };
+
+    /**************
+     * xcsv_stats *
+     **************/
+
+    /**
+     * Statistics reported by read_csv.
+     */
+    struct xcsv_stats
+    {
+        std::size_t m_rows = 0;
+        double m_seconds = 0.;
+
+        double rows_per_second() const noexcept;
+    };
+
+    template <class V>
+    V read_csv(const std::string& path,
+               const typename V::dimension_list& dims,
+               const typename V::key_type& value_column,
+               const xcsv_options& options = xcsv_options(),
+               xcsv_stats* stats = nullptr);
+
+    /******************************
+     * xcsv_reader implementation *
+     ******************************/
+
+    /**
+     * Returns the number of data rows read per second.
+     */
+    inline double xcsv_stats::rows_per_second() const noexcept
+    {
+        return m_seconds > 0. ? static_cast<double>(m_rows) / m_seconds : 0.;
+    }
+
+    namespace detail
+    {
+        using csv_field = std::pair<const char*, const char*>;
+
+        // Calls f(first, last) on consecutive blocks of complete lines of
+        // the stream. Lines longer than the chunk size grow the buffer.
+        template <class F>
+        inline void for_each_csv_chunk(std::istream& in, std::size_t chunk_size, F&& f)
+        {
+            std::vector<char> buffer(std::max(chunk_size, std::size_t(1)));
+            std::size_t carry = 0;
+            while (true)
+            {
+                in.read(buffer.data() + carry, static_cast<std::streamsize>(buffer.size() - carry));
+                std::size_t size = carry + static_cast<std::size_t>(in.gcount());
+                if (!in)
+                {
+                    if (size != 0)
+                    {
+                        f(buffer.data(), buffer.data() + size);
+                    }
+                    return;
+                }
+                const char* last_line = buffer.data() + size;
+                while (last_line != buffer.data() && *(last_line - 1) != '\n')
+                {
+                    --last_line;
+                }
+                if (last_line == buffer.data())
+                {
+                    carry = size;
+                    buffer.resize(2 * buffer.size());
+                    continue;
+                }
+                f(buffer.data(), last_line);
+                carry = static_cast<std::size_t>(buffer.data() + size - last_line);
+                std::memmove(buffer.data(), last_line, carry);
+            }
+        }
+
+        // Calls f(first, last) for each non-empty line of [first, last),
+        // without the line terminator.
+        template <class F>
+        inline void for_each_csv_line(const char* first, const char* last, F&& f)
+        {
+            while (first != last)
+            {
+                const char* end = static_cast<const char*>(std::memchr(first, '\n', static_cast<std::size_t>(last - first)));
+                end = end == nullptr ? last : end;
+                const char* line_end = (end != first && *(end - 1) == '\r') ? end - 1 : end;
+                if (line_end != first)
+                {
+                    f(first, line_end);
+                }
+                first = end == last ? last : end + 1;
+            }
+        }
+
+        inline void split_csv_line(const char* first, const char* last, char separator, std::vector<csv_field>& fields)
+        {
+            fields.clear();
+            const char* field = first;
+            for (const char* it = first; it != last; ++it)
+            {
+                if (*it == separator)
+                {
+                    fields.emplace_back(field, it);
+                    field = it + 1;
+                }
+            }
+            fields.emplace_back(field, last);
+        }
+
+        inline bool is_csv_missing(const char* first, const char* last) noexcept
+        {
+            std::size_t size = static_cast<std::size_t>(last - first);
+            return size == 0 ||
+                (size == 2 && std::memcmp(first, "NA", 2) == 0) ||
+                (size == 3 && (std::memcmp(first, "NaN", 3) == 0 || std::memcmp(first, "nan", 3) == 0));
+        }
+
+        // Decimal numbers with at most 15 significant digits and a small
+        // exponent are computed exactly with a single floating point
+        // operation; other numbers fall back to strtod.
+        inline bool parse_csv_number(const char* first, const char* last, double& res)
+        {
+            static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                             1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+            const char* p = first;
+            bool negative = false;
+            if (p != last && (*p == '-' || *p == '+'))
+            {
+                negative = *p == '-';
+                ++p;
+            }
+
+            std::uint64_t mantissa = 0;
+            int digits = 0;
+            int exponent = 0;
+            bool has_digits = false;
+            for (; p != last && *p >= '0' && *p <= '9'; ++p)
+            {
+                has_digits = true;
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+                    digits += mantissa != 0;
+                }
+                else
+                {
+                    ++exponent;
+                }
+            }
+            if (p != last && *p == '.')
+            {
+                for (++p; p != last && *p >= '0' && *p <= '9'; ++p)
+                {
+                    has_digits = true;
+                    if (digits < 19)
+                    {
+                        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+                        digits += mantissa != 0;
+                        --exponent;
+                    }
+                }
+            }
+            if (!has_digits)
+            {
+                return false;
+            }
+            if (p != last && (*p == 'e' || *p == 'E'))
+            {
+                ++p;
+                bool negative_exponent = false;
+                if (p != last && (*p == '-' || *p == '+'))
+                {
+                    negative_exponent = *p == '-';
+                    ++p;
+                }
+                int e = 0;
+                bool has_exponent = false;
+                for (; p != last && *p >= '0' && *p <= '9'; ++p)
+                {
+                    has_exponent = true;
+                    e = std::min(e * 10 + (*p - '0'), 100000);
+                }
+                if (!has_exponent)
+                {
+                    return false;
+                }
+                exponent += negative_exponent ? -e : e;
+            }
+            if (p != last)
+            {
+                return false;
+            }
+
+            if (digits <= 15 && exponent >= -22 && exponent <= 22)
+            {
+                double value = static_cast<double>(mantissa);
+                value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+                res = negative ? -value : value;
+                return true;
+            }
+            std::string tmp(first, last);
+            char* end = nullptr;
+            res = std::strtod(tmp.c_str(), &end);
+            return end == tmp.c_str() + tmp.size();
+        }
+
+        template <class T>
+        inline bool parse_csv_value(const char* first, const char* last, T& res, std::false_type)
+        {
+            double tmp;
+            bool ok = parse_csv_number(first, last, tmp);
+            res = static_cast<T>(tmp);
+            return ok;
+        }
+
+        template <class T>
+        inline bool parse_csv_value(const char* first, const char* last, T& res, std::true_type)
+        {
+            const char* p = first;
+            bool negative = false;
+            if (p != last && (*p == '-' || *p == '+'))
+            {
+                negative = *p == '-';
+                ++p;
+            }
+            if (p == last || (negative && std::is_unsigned<T>::value))
+            {
+                return false;
+            }
+            using wide_type = std::conditional_t<std::is_signed<T>::value, long long, unsigned long long>;
+            const wide_type limit = negative ? static_cast<wide_type>(std::numeric_limits<T>::lowest())
+                                             : static_cast<wide_type>(std::numeric_limits<T>::max());
+            wide_type value = 0;
+            for (; p != last; ++p)
+            {
+                if (*p < '0' || *p > '9')
+                {
+                    return false;
+                }
+                wide_type digit = static_cast<wide_type>(*p - '0');
+                if (negative ? value < (limit + digit) / 10 : value > (limit - digit) / 10)
+                {
+                    return false;
+                }
+                value = negative ? value * 10 - digit : value * 10 + digit;
+            }
+            res = static_cast<T>(value);
+            return true;
+        }
+
+        template <class T>
+        inline bool parse_csv_value(const char* first, const char* last, T& res)
+        {
+            return parse_csv_value(first, last, res, std::is_integral<T>());
+        }
+
+        template <class T, class TL>
+        struct has_label_type;
+
+        template <class T, template <class...> class TL, class... L>
+        struct has_label_type<T, TL<L...>>
+            : xtl::disjunction<std::is_same<T, L>...>
+        {
+        };
+
+        /******************
+         * xcsv_dimension *
+         ******************/
+
+        // Labels of a dimension discovered in the file, in their order of
+        // appearance.
+        class xcsv_dimension
+        {
+        public:
+
+            std::size_t size() const noexcept
+            {
+                return m_labels.size();
+            }
+
+            void insert(const char* first, const char* last)
+            {
+                m_key.assign(first, last);
+                if (m_positions.find(m_key) == m_positions.end())
+                {
+                    m_positions.emplace(m_key, m_labels.size());
+                    m_labels.push_back(m_key);
+                }
+            }
+
+            // Thread-safe once all the labels have been inserted.
+            std::size_t position(const char* first, const char* last) const
+            {
+                auto it = m_positions.find(std::string(first, last));
+                if (it == m_positions.end())
+                {
+                    throw std::runtime_error("read_csv: the file changed while being read");
+                }
+                return it->second;
+            }
+
+            // Returns true and fills res if all the labels are distinct
+            // integers.
+            bool as_integers(std::vector<int>& res) const
+            {
+                res.resize(m_labels.size());
+                std::unordered_set<int> seen;
+                for (std::size_t i = 0; i < m_labels.size(); ++i)
+                {
+                    const std::string& l = m_labels[i];
+                    if (!parse_csv_value(l.data(), l.data() + l.size(), res[i]) || !seen.insert(res[i]).second)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            const std::vector<std::string>& labels() const noexcept
+            {
+                return m_labels;
+            }
+
+        private:
+
+            std::unordered_map<std::string, std::size_t> m_positions;
+            std::vector<std::string> m_labels;
+            std::string m_key;
+        };
+
+        template <class A, class L>
+        inline A make_csv_axis(const xcsv_dimension& dim, std::false_type)
+        {
+            using mapped_type = typename A::mapped_type;
+            using map_tag = typename A::map_container_tag;
+            using string_type = XFRAME_STRING_LABEL;
+            static_assert(has_label_type<string_type, L>::value, "read_csv requires the string label type in the label list");
+            std::vector<string_type> labels;
+            labels.reserve(dim.size());
+            for (const auto& l : dim.labels())
+            {
+                labels.push_back(string_type(l.c_str()));
+            }
+            return A(xaxis<string_type, mapped_type, map_tag>(std::move(labels)));
+        }
+
+        template <class A, class L>
+        inline A make_csv_axis(const xcsv_dimension& dim, std::true_type)
+        {
+            using mapped_type = typename A::mapped_type;
+            using map_tag = typename A::map_container_tag;
+            std::vector<int> ints;
+            if (dim.as_integers(ints))
+            {
+                return A(xaxis<int, mapped_type, map_tag>(std::move(ints)));
+            }
+            return make_csv_axis<A, L>(dim, std::false_type());
+        }
+
+        inline std::size_t find_csv_column(const std::vector<std::string>& header, const std::string& name)
+        {
+            auto it = std::find(header.cbegin(), header.cend(), name);
+            if (it == header.cend())
+            {
+                throw std::invalid_argument("read_csv: no column " + name);
+            }
+            return static_cast<std::size_t>(it - header.cbegin());
+        }
+
+        template <class V>
+        inline bool use_parallel_csv(std::size_t nb_lines)
+        {
+#if XFRAME_ENABLE_PARALLEL_ASSIGN
+            // Bits of a bitset mask are not independent memory locations.
+            return !has_bitset_mask<typename V::data_type>::value &&
+                nb_lines >= std::size_t(1024) &&
+                assign_thread_count() > 1;
+#else
+            (void)nb_lines;
+            return false;
+#endif
+        }
+    }
+
+    /**
+     * Reads a variable from a CSV file in long format: each line holds the
+     * labels of an element, one column per dimension, and its value. The
+     * first line holds the names of the columns; other columns are ignored.
+     * Fields are not quoted.
+     *
+     * The file is read twice, by chunks: the first pass discovers the labels
+     * of each dimension, the second one parses the values and writes them
+     * in the variable, allocated with its final size. The memory used is the
+     * size of a chunk plus the size of the variable and of its labels.
+     * When parallel assignment is enabled, the lines of a chunk are parsed
+     * by several threads, and their values are written in line order.
+     *
+     * The labels of a dimension are integers if all of them are integers,
+     * strings otherwise, in their order of appearance. Elements absent from
+     * the file, empty values and \c NA or \c NaN values are missing. When
+     * several lines hold the same labels, the last one wins.
+     *
+     * @tparam V the type of the variable, e.g. \c xvariable<double, xcoordinate<fstring>>.
+     * @param path the path of the file.
+     * @param dims the names of the columns holding the labels, giving the
+     * dimensions of the variable in their order.
+     * @param value_column the name of the column holding the values.
+     * @param options the separator and the chunk size.
+     * @param stats if not null, receives the number of rows and the time spent.
+     * @throw std::invalid_argument if a column is not found.
+     * @throw std::runtime_error if the file cannot be read, or if a line has
+     * too few fields or an invalid value.
+     */
+    template <class V>
+    inline V read_csv(const std::string& path,
+                      const typename V::dimension_list& dims,
+                      const typename V::key_type& value_column,
+                      const xcsv_options& options,
+                      xcsv_stats* stats)
+    {
+        using value_type = typename std::decay_t<decltype(std::declval<V&>().data().value())>::value_type;
+        using coordinate_map = typename V::coordinate_map;
+        using axis_type = typename V::coordinate_type::axis_type;
+        using label_list = typename V::coordinate_type::label_list;
+        using size_type = std::size_t;
+        static_assert(std::is_arithmetic<value_type>::value, "read_csv requires arithmetic values");
+
+        auto start = std::chrono::steady_clock::now();
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            throw std::runtime_error("read_csv: cannot open " + path);
+        }
+
+        std::string header_line;
+        std::getline(in, header_line);
+        if (!header_line.empty() && header_line.back() == '\r')
+        {
+            header_line.pop_back();
+        }
+        std::streampos data_start = in.tellg();
+        std::vector<detail::csv_field> fields;
+        detail::split_csv_line(header_line.data(), header_line.data() + header_line.size(), options.m_separator, fields);
+        std::vector<std::string> header;
+        for (const auto& f : fields)
+        {
+            header.emplace_back(f.first, f.second);
+        }
+
+        size_type dimension = dims.size();
+        std::vector<size_type> columns(dimension);
+        size_type nb_fields = 0;
+        for (size_type d = 0; d < dimension; ++d)
+        {
+            columns[d] = detail::find_csv_column(header, std::string(dims[d].c_str()));
+            nb_fields = std::max(nb_fields, columns[d] + 1);
+        }
+        size_type value_index = detail::find_csv_column(header, std::string(value_column.c_str()));
+        nb_fields = std::max(nb_fields, value_index + 1);
+
+        // First pass: discovers the labels.
+        std::vector<detail::xcsv_dimension> labels(dimension);
+        detail::for_each_csv_chunk(in, options.m_chunk_size, [&](const char* first, const char* last)
+        {
+            detail::for_each_csv_line(first, last, [&](const char* line, const char* line_end)
+            {
+                detail::split_csv_line(line, line_end, options.m_separator, fields);
+                if (fields.size() < nb_fields)
+                {
+                    throw std::runtime_error("read_csv: missing field in line " + std::string(line, line_end));
+                }
+                for (size_type d = 0; d < dimension; ++d)
+                {
+                    labels[d].insert(fields[columns[d]].first, fields[columns[d]].second);
+                }
+            });
+        });
+
+        coordinate_map coords;
+        std::vector<size_type> strides(dimension);
+        size_type stride = 1;
+        for (size_type d = dimension; d != 0; --d)
+        {
+            coords[dims[d - 1]] = detail::make_csv_axis<axis_type, label_list>(labels[d - 1], detail::has_label_type<int, label_list>());
+            strides[d - 1] = stride;
+            stride *= labels[d - 1].size();
+        }
+        V res(std::move(coords), typename V::dimension_list(dims));
+        value_type* values = res.data().value().data();
+        auto& mask = res.data().has_value().storage();
+        std::fill(mask.begin(), mask.end(), false);
+
+        // Second pass: parses and scatters the values. Parsing a line gives
+        // the offset of its element and its value, has_value is false for
+        // missing values.
+        auto parse_line = [&](const char* line, const char* line_end, std::vector<detail::csv_field>& line_fields,
+                              size_type& offset, value_type& value, bool& has_value)
+        {
+            detail::split_csv_line(line, line_end, options.m_separator, line_fields);
+            if (line_fields.size() < nb_fields)
+            {
+                throw std::runtime_error("read_csv: missing field in line " + std::string(line, line_end));
+            }
+            offset = 0;
+            for (size_type d = 0; d < dimension; ++d)
+            {
+                const auto& f = line_fields[columns[d]];
+                offset += labels[d].position(f.first, f.second) * strides[d];
+            }
+            const auto& f = line_fields[value_index];
+            has_value = !detail::is_csv_missing(f.first, f.second);
+            if (has_value && !detail::parse_csv_value(f.first, f.second, value))
+            {
+                throw std::runtime_error("read_csv: invalid value " + std::string(f.first, f.second));
+            }
+        };
+
+        auto write_value = [values, &mask](size_type offset, const value_type& value, bool has_value)
+        {
+            if (has_value)
+            {
+                values[offset] = value;
+            }
+            mask[offset] = has_value;
+        };
+
+        size_type nb_rows = 0;
+        std::vector<std::pair<const char*, const char*>> lines;
+        struct parsed_line
+        {
+            size_type m_offset;
+            value_type m_value;
+            bool m_has_value;
+        };
+        std::vector<parsed_line> parsed;
+        in.clear();
+        in.seekg(data_start);
+        detail::for_each_csv_chunk(in, options.m_chunk_size, [&](const char* first, const char* last)
+        {
+            lines.clear();
+            detail::for_each_csv_line(first, last, [&lines](const char* line, const char* line_end)
+            {
+                lines.emplace_back(line, line_end);
+            });
+            nb_rows += lines.size();
+            if (detail::use_parallel_csv<V>(lines.size()))
+            {
+                // Lines holding the same labels write the same element: the
+                // lines are parsed in parallel, but their values are written
+                // sequentially, in line order, so that the last one wins.
+                parsed.resize(lines.size());
+                xthread_pool::instance().parallel_for_range(lines.size(), [&](size_type begin, size_type end)
+                {
+                    std::vector<detail::csv_field> line_fields;
+                    for (size_type i = begin; i < end; ++i)
+                    {
+                        auto& p = parsed[i];
+                        parse_line(lines[i].first, lines[i].second, line_fields, p.m_offset, p.m_value, p.m_has_value);
+                    }
+                });
+                for (const auto& p : parsed)
+                {
+                    write_value(p.m_offset, p.m_value, p.m_has_value);
+                }
+            }
+            else
+            {
+                size_type offset = 0;
+                value_type value = value_type();
+                bool has_value = false;
+                for (const auto& l : lines)
+                {
+                    parse_line(l.first, l.second, fields, offset, value, has_value);
+                    write_value(offset, value, has_value);
+                }
+            }
+        });
+
+        if (stats != nullptr)
+        {
+            stats->m_rows = nb_rows;
+            stats->m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        return res;
+    }
+}
+
+#endif
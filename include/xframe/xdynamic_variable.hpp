@@ -137,10 +137,34 @@ namespace xf
         template <std::size_t N = dynamic()>
         const_reference iselect(iselector_sequence_type<N>&& sel) const;
 
+        template <class V>
+        V* get_if() noexcept;
+
+        template <class V>
+        const V* get_if() const noexcept;
+
+        template <class V>
+        V& get();
+
+        template <class V>
+        const V& get() const;
+
+        template <class... V, class F>
+        bool visit_data(F&& f);
+
+        template <class... V, class F>
+        bool visit_data(F&& f) const;
+
+        template <class U>
+        void copy_to(U* values, bool* mask = nullptr) const;
+
         std::ostream& print(std::ostream& out) const;
 
     private:
 
+        template <class V, class W, class F>
+        static bool visit_data_impl(W& wrapper, F& f);
+
         template <class... Args>
         index_type<> make_index(Args... args);
 
@@ -393,12 +417,110 @@ namespace xf
         return p_wrapper->template iselect<N>(std::move(sel));
     }
 
+    /**
+     * Returns a pointer to the wrapped variable if its type is \c V,
+     * a null pointer otherwise.
+     */
+    template <class C, class DM, class T>
+    template <class V>
+    inline V* xdynamic_variable<C, DM, T>::get_if() noexcept
+    {
+        return p_wrapper->template get_if<V>();
+    }
+
+    template <class C, class DM, class T>
+    template <class V>
+    inline const V* xdynamic_variable<C, DM, T>::get_if() const noexcept
+    {
+        return static_cast<const wrapper_type*>(p_wrapper)->template get_if<V>();
+    }
+
+    /**
+     * Returns a reference to the wrapped variable, whose elements can then
+     * be accessed without virtual call nor boxing.
+     * @throw std::bad_cast if the type of the wrapped variable is not \c V.
+     */
+    template <class C, class DM, class T>
+    template <class V>
+    inline V& xdynamic_variable<C, DM, T>::get()
+    {
+        V* res = get_if<V>();
+        if (res == nullptr)
+        {
+            throw std::bad_cast();
+        }
+        return *res;
+    }
+
+    template <class C, class DM, class T>
+    template <class V>
+    inline const V& xdynamic_variable<C, DM, T>::get() const
+    {
+        const V* res = get_if<V>();
+        if (res == nullptr)
+        {
+            throw std::bad_cast();
+        }
+        return *res;
+    }
+
+    /**
+     * Calls \c f once with the wrapped variable if its type is one of
+     * the candidate types \c V, so that bulk operations are dispatched
+     * once per call instead of once per element.
+     * @return true if \c f has been called.
+     */
+    template <class C, class DM, class T>
+    template <class... V, class F>
+    inline bool xdynamic_variable<C, DM, T>::visit_data(F&& f)
+    {
+        bool found = false;
+        using expander = int[];
+        (void)expander{ 0, (found = found || visit_data_impl<V>(*p_wrapper, f), 0)... };
+        return found;
+    }
+
+    template <class C, class DM, class T>
+    template <class... V, class F>
+    inline bool xdynamic_variable<C, DM, T>::visit_data(F&& f) const
+    {
+        bool found = false;
+        using expander = int[];
+        (void)expander{ 0, (found = found || visit_data_impl<V>(static_cast<const wrapper_type&>(*p_wrapper), f), 0)... };
+        return found;
+    }
+
+    /**
+     * Copies the values of the variable in row-major order with a single
+     * virtual call, and its missing mask if \c mask is not null.
+     * @throw std::bad_cast if \c U is not the value type of the wrapped variable.
+     */
+    template <class C, class DM, class T>
+    template <class U>
+    inline void xdynamic_variable<C, DM, T>::copy_to(U* values, bool* mask) const
+    {
+        p_wrapper->copy_values(values, mask, typeid(U));
+    }
+
     template <class C, class DM, class T>
     inline std::ostream& xdynamic_variable<C, DM, T>::print(std::ostream& out) const
     {
         return p_wrapper->print(out);
     }
 
+    template <class C, class DM, class T>
+    template <class V, class W, class F>
+    inline bool xdynamic_variable<C, DM, T>::visit_data_impl(W& wrapper, F& f)
+    {
+        auto* variable = wrapper.template get_if<V>();
+        if (variable != nullptr)
+        {
+            f(*variable);
+            return true;
+        }
+        return false;
+    }
+
     template <class C, class DM, class T>
     template <class... Args>
     inline auto xdynamic_variable<C, DM, T>::make_index(Args... args) -> index_type<>
@@ -11,6 +11,8 @@
 #ifndef XFRAME_XDYNAMIC_VARIABLE_IMPL_HPP
 #define XFRAME_XDYNAMIC_VARIABLE_IMPL_HPP
 
+#include <typeinfo>
+
 #include "xtl/xany.hpp"
 #include "xtl/xhierarchy_generator.hpp"
 #include "xtl/xvariant.hpp"
@@ -238,6 +240,14 @@ namespace xf
 
         virtual std::ostream& print(std::ostream& out) const = 0;
 
+        virtual void copy_values(void* values, bool* mask, const std::type_info& type) const = 0;
+
+        template <class V>
+        V* get_if() noexcept;
+
+        template <class V>
+        const V* get_if() const noexcept;
+
     protected:
 
         xvariable_wrapper() = default;
@@ -282,15 +292,17 @@ namespace xf
 
         std::ostream& print(std::ostream& out) const override;
 
+        void copy_values(void* values, bool* mask, const std::type_info& type) const override;
+
+        variable_type& get_variable();
+        const variable_type& get_variable() const;
+
     protected:
 
         xvariable_wrapper_impl(const variable_type& variable);
         xvariable_wrapper_impl(variable_type&& variable);
         xvariable_wrapper_impl(const self_type& rhs) = default;
 
-        variable_type& get_variable();
-        const variable_type& get_variable() const;
-
     private:
 
         variable_type m_variable;
@@ -526,6 +538,22 @@ namespace xf
         return base.do_iselect(std::move(sel));
     }
 
+    template <class C, class DM, class T>
+    template <class V>
+    inline V* xvariable_wrapper<C, DM, T>::get_if() noexcept
+    {
+        auto* impl = dynamic_cast<xvariable_wrapper_impl<V, T>*>(this);
+        return impl != nullptr ? &(impl->get_variable()) : nullptr;
+    }
+
+    template <class C, class DM, class T>
+    template <class V>
+    inline const V* xvariable_wrapper<C, DM, T>::get_if() const noexcept
+    {
+        const auto* impl = dynamic_cast<const xvariable_wrapper_impl<V, T>*>(this);
+        return impl != nullptr ? &(impl->get_variable()) : nullptr;
+    }
+
     /*****************************************
      * xvariable_wrapper_impl implementation *
      *****************************************/
@@ -614,6 +642,28 @@ namespace xf
         return out << m_variable;
     }
 
+    template <class V, class T>
+    void xvariable_wrapper_impl<V, T>::copy_values(void* values, bool* mask, const std::type_info& type) const
+    {
+        using data_type = std::decay_t<decltype(m_variable.data())>;
+        using value_type = typename data_type::value_type::value_type;
+        if (type != typeid(value_type))
+        {
+            throw std::bad_cast();
+        }
+        value_type* out = static_cast<value_type*>(values);
+        const data_type& data = m_variable.data();
+        for (auto it = data.cbegin(); it != data.cend(); ++it, ++out)
+        {
+            auto val = *it;
+            *out = val.value();
+            if (mask != nullptr)
+            {
+                *mask++ = val.has_value();
+            }
+        }
+    }
+
    /***************************
     * xdynamic_implementation *
     ***************************/
@@ -16,6 +16,7 @@
 #define XFRAME_VERSION_PATCH 0
 
 #include "xtl/xbasic_fixed_string.hpp"
+#include "xinterned_string.hpp"
 namespace xf
 {
     using fstring = xtl::xfixed_string<55>;
@@ -35,17 +36,40 @@ namespace xf
 #define XFRAME_DEFAULT_JOIN join::inner
 #endif
 
+// Stores the missing masks of the default data container with one bit
+// per element instead of one byte.
+#ifndef XFRAME_ENABLE_BITSET_MASK
+#define XFRAME_ENABLE_BITSET_MASK 0
+#endif
+
 #ifndef XFRAME_DEFAULT_DATA_CONTAINER
+#if XFRAME_ENABLE_BITSET_MASK
+#include "xbitset_mask.hpp"
+#define XFRAME_DEFAULT_DATA_CONTAINER(T) xf::xbitset_optional<T>
+#else
 #include "xtensor/xarray.hpp"
 #include "xtensor/xoptional_assembly.hpp"
 #define XFRAME_DEFAULT_DATA_CONTAINER(T) xt::xoptional_assembly<xt::xarray<T>, xt::xarray<bool>>
 #endif
+#endif
 
 // A higher number leads to an ICE on VS 2015
 #ifndef XFRAME_STATIC_DIMENSION_LIMIT
 #define XFRAME_STATIC_DIMENSION_LIMIT 4
 #endif
 
+// Enables multi-threaded evaluation of the assignment of variables, the
+// number of threads is set at runtime with xf::set_assign_thread_count.
+#ifndef XFRAME_ENABLE_PARALLEL_ASSIGN
+#define XFRAME_ENABLE_PARALLEL_ASSIGN 0
+#endif
+
+// Minimal number of elements of an assigned variable for the assignment
+// to run in parallel.
+#ifndef XFRAME_PARALLEL_ASSIGN_THRESHOLD
+#define XFRAME_PARALLEL_ASSIGN_THRESHOLD 65536
+#endif
+
 #ifndef XFRAME_ENABLE_TRACE
 #define XFRAME_ENABLE_TRACE 0
 #endif
@@ -11,9 +11,15 @@
 #ifndef XFRAME_XFRAME_UTILS_HPP
 #define XFRAME_XFRAME_UTILS_HPP
 
+#include <algorithm>
+#include <array>
+#include <initializer_list>
 #include <iterator>
 #include <ostream>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "xtensor/xio.hpp"
 
@@ -39,61 +45,137 @@ namespace xf
 
     namespace detail
     {
-        template <class C0, class C1>
-        inline bool merge_containers(C0& output, const C1& input)
+        template <class S, std::size_t N>
+        struct xselector_sequence
         {
-            bool res = !(input.size() < output.size());
-            auto output_iter = output.begin();
-            auto output_end = output.end();
-            auto first = input.begin();
-            auto last = input.end();
-            while(first != last && output_iter != output_end)
+            using type = std::conditional_t<N == std::numeric_limits<std::size_t>::max(), std::vector<S>, std::array<S, N>>;
+        };
+
+        template <class S, std::size_t N>
+        using xselector_sequence_t = typename xselector_sequence<S, N>::type;
+
+        template <class V, class... C>
+        struct has_common_iterator_impl : std::false_type
+        {
+        };
+
+        template <class... C>
+        struct has_common_iterator_impl<xt::void_t<std::common_type_t<typename C::const_iterator...>>, C...>
+            : std::true_type
+        {
+        };
+
+        template <class... C>
+        using has_common_iterator = has_common_iterator_impl<void, C...>;
+
+        // Single pass over all the containers, the result is built in a
+        // buffer allocated once and then swapped with output.
+        template <class CO, class... CI>
+        inline bool merge_to_impl(std::true_type, CO& output, const CI&... input)
+        {
+            using iterator = std::common_type_t<typename CO::const_iterator, typename CI::const_iterator...>;
+            using range_type = std::pair<iterator, iterator>;
+            using value_type = typename CO::value_type;
+            constexpr std::size_t nb_ranges = sizeof...(CI) + 1;
+
+            std::array<range_type, nb_ranges> ranges = {{ range_type(output.cbegin(), output.cend()),
+                                                          range_type(input.cbegin(), input.cend())... }};
+            std::array<bool, nb_ranges> same_labels;
+            same_labels.fill(true);
+
+            std::size_t capacity = 0;
+            for (const auto& r : ranges)
+            {
+                capacity += static_cast<std::size_t>(std::distance(r.first, r.second));
+            }
+            CO res;
+            res.reserve(capacity);
+
+            while (true)
             {
-                if(*first < *output_iter)
+                const value_type* min_value = nullptr;
+                for (const auto& r : ranges)
                 {
-                    output_iter = output.insert(output_iter, *first++);
-                    output_end = output.end();
-                    res = false;
+                    if (r.first != r.second && (min_value == nullptr || *(r.first) < *min_value))
+                    {
+                        min_value = &*(r.first);
+                    }
                 }
-                else if(*first == *output_iter)
+                if (min_value == nullptr)
                 {
-                    ++first;
+                    break;
+                }
+                res.push_back(*min_value);
+                const value_type& last = res.back();
+                for (std::size_t i = 0; i < nb_ranges; ++i)
+                {
+                    range_type& r = ranges[i];
+                    if (r.first != r.second && *(r.first) == last)
+                    {
+                        ++(r.first);
+                    }
+                    else
+                    {
+                        same_labels[i] = false;
+                    }
                 }
-                ++output_iter;
             }
-            res &= output.empty() || (first == last);
-            std::copy(first, last, std::back_inserter(output));
-            return res;
+
+            bool result = output.empty() || same_labels[0];
+            for (std::size_t i = 1; i < nb_ranges; ++i)
+            {
+                result &= same_labels[i];
+            }
+            output.swap(res);
+            return result;
         }
 
-        template <class C0>
-        inline bool merge_to_impl(C0&)
+        template <class CO>
+        inline void merge_sorted_to(CO&)
         {
-            return true;
         }
 
-        template <class C0, class C1, class... C>
-        inline bool merge_to_impl(C0& out, C1& in, const C&... input)
+        template <class CO, class C1, class... C>
+        inline void merge_sorted_to(CO& output, const C1& in, const C&... input)
         {
-            bool res = merge_containers(out, in);
-            res &= merge_to_impl(out, input...);
-            return res;
+            CO res;
+            res.reserve(output.size() + static_cast<std::size_t>(std::distance(in.begin(), in.end())));
+            std::set_union(output.cbegin(), output.cend(), in.begin(), in.end(), std::back_inserter(res));
+            output.swap(res);
+            merge_sorted_to(output, input...);
         }
 
-        template <class S, std::size_t N>
-        struct xselector_sequence
+        // Containers with different iterator types, such as label ranges
+        // computed on the fly, are merged one at a time. Labels are unique,
+        // so a container holds all the merged labels iff it has their count.
+        template <class CO, class... CI>
+        inline bool merge_to_impl(std::false_type, CO& output, const CI&... input)
         {
-            using type = std::conditional_t<N == std::numeric_limits<std::size_t>::max(), std::vector<S>, std::array<S, N>>;
-        };
-
-        template <class S, std::size_t N>
-        using xselector_sequence_t = typename xselector_sequence<S, N>::type;
+            std::size_t output_size = output.size();
+            merge_sorted_to(output, input...);
+            bool result = output_size == std::size_t(0) || output_size == output.size();
+            for (std::size_t size : std::initializer_list<std::size_t>{ static_cast<std::size_t>(std::distance(input.begin(), input.end()))... })
+            {
+                result &= (size == output.size());
+            }
+            return result;
+        }
     }
 
+    /**
+     * Merges the sorted containers \c input into the sorted container \c output.
+     * When all the containers share their iterator type, the merge is done in
+     * a single pass over all of them; otherwise the inputs are merged one at a
+     * time.
+     * @param output the container to merge into.
+     * @param input the containers to merge.
+     * @return true if \c output and all the \c input containers already
+     *         held the same labels.
+     */
     template <class CO, class... CI>
     inline bool merge_to(CO& output, const CI&... input)
     {
-        return detail::merge_to_impl(output, input...);
+        return detail::merge_to_impl(detail::has_common_iterator<CO, CI...>(), output, input...);
     }
 
     /*******************************
@@ -105,31 +187,27 @@ namespace xf
         template <class C0, class C1>
         inline bool intersect_containers(C0& output, const C1& input)
         {
-            bool res = !(input.size() < output.size());
-            auto output_iter = output.begin();
-            auto output_end = output.end();
             auto first = input.begin();
             auto last = input.end();
-            while(first != last && output_iter != output_end)
+            auto output_iter = output.begin();
+            for (auto iter = output.begin(); iter != output.end(); ++iter)
             {
-                if(*first < *output_iter)
+                while (first != last && *first < *iter)
                 {
                     ++first;
                 }
-                else if(*first == *output_iter)
+                if (first != last && *first == *iter)
                 {
-                    ++first;
+                    if (output_iter != iter)
+                    {
+                        *output_iter = std::move(*iter);
+                    }
                     ++output_iter;
-                }
-                else // *first > *output_iter
-                {
-                    output_iter = output.erase(output_iter);
-                    output_end = output.end();
-                    res = false;
+                    ++first;
                 }
             }
-            res &= (output_iter == output_end);
-            output.erase(output_iter, output_end);
+            bool res = (output_iter == output.end());
+            output.erase(output_iter, output.end());
             return res;
         }
 
@@ -148,6 +226,14 @@ namespace xf
         }
     }
 
+    /**
+     * Replaces the sorted container \c output with its intersection with
+     * the sorted containers \c input. Each input is processed in a single
+     * pass and the kept labels are compacted in place.
+     * @param output the container to intersect.
+     * @param input the containers to intersect with.
+     * @return true if the intersection is equivalent to \c output.
+     */
     template <class CO, class... CI>
     inline bool intersect_to(CO& output, const CI&... input)
     {
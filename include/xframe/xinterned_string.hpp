@@ -0,0 +1,505 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XFRAME_XINTERNED_STRING_HPP
+#define XFRAME_XINTERNED_STRING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace xf
+{
+    /****************
+     * xstring_pool *
+     ****************/
+
+    /**
+     * @class xstring_pool
+     * @brief Process-wide pool of interned strings.
+     *
+     * The xstring_pool assigns a unique 32-bit id to each distinct string
+     * it is given, and stores each string only once. Interning a string
+     * is thread-safe; finding the id of a string only takes a shared lock,
+     * and reading the string of an id does not lock, the storage of an id
+     * never moves once the id has been returned.
+     */
+    class xstring_pool
+    {
+    public:
+
+        using id_type = std::uint32_t;
+        using size_type = std::size_t;
+
+        static constexpr id_type invalid_id = std::numeric_limits<id_type>::max();
+
+        static xstring_pool& instance();
+
+        ~xstring_pool();
+
+        xstring_pool(const xstring_pool&) = delete;
+        xstring_pool& operator=(const xstring_pool&) = delete;
+        xstring_pool(xstring_pool&&) = delete;
+        xstring_pool& operator=(xstring_pool&&) = delete;
+
+        id_type intern(const std::string& str);
+        id_type intern(std::string&& str);
+
+        id_type find(const std::string& str) const;
+
+        const std::string& str(id_type id) const noexcept;
+        size_type size() const;
+
+    private:
+
+        static constexpr size_type chunk_bits = 12;
+        static constexpr size_type chunk_size = size_type(1) << chunk_bits;
+        static constexpr size_type chunk_mask = chunk_size - 1;
+        static constexpr size_type max_chunks = size_type(1) << 16;
+
+        using chunk_type = const std::string*;
+        using map_type = std::unordered_map<std::string, id_type>;
+
+        xstring_pool();
+
+        template <class S>
+        id_type intern_impl(S&& str);
+
+        map_type m_ids;
+        std::array<std::atomic<chunk_type*>, max_chunks> m_chunks;
+        size_type m_size;
+        mutable std::shared_timed_mutex m_mutex;
+    };
+
+    /********************
+     * xinterned_string *
+     ********************/
+
+    /**
+     * @class xinterned_string
+     * @brief Compact string label.
+     *
+     * The xinterned_string stores the id of a string in the global
+     * xstring_pool. It is 4 bytes wide, while hashing and equality
+     * comparison are integer operations. Ordering is lexicographic so
+     * that sorted axes of interned strings sort like regular strings.
+     *
+     * To use it as the string label of the default label list, define
+     * \c XFRAME_STRING_LABEL to \c xf::istring before including xframe.
+     *
+     * Building an xinterned_string from a string interns it for the
+     * lifetime of the process. Keys that are only looked up should be
+     * built with \c lookup, which does not grow the pool: an unknown
+     * string gives an invalid key that differs from every label.
+     * Selectors and locators of variables hold xinterned_string_key
+     * instead, so that the labels they are given are looked up.
+     */
+    class xinterned_string_key;
+
+    class xinterned_string
+    {
+    public:
+
+        using id_type = xstring_pool::id_type;
+        using size_type = std::string::size_type;
+        using lookup_type = xinterned_string_key;
+
+        xinterned_string();
+        xinterned_string(const char* str);
+        xinterned_string(const std::string& str);
+        xinterned_string(std::string&& str);
+
+        static xinterned_string lookup(const char* str);
+        static xinterned_string lookup(const std::string& str);
+
+        const std::string& str() const noexcept;
+        const char* c_str() const noexcept;
+
+        size_type size() const noexcept;
+        bool empty() const noexcept;
+
+        id_type id() const noexcept;
+        bool valid() const noexcept;
+
+    private:
+
+        static xinterned_string from_id(id_type id) noexcept;
+
+        id_type m_id;
+    };
+
+    using istring = xinterned_string;
+
+    /************************
+     * xinterned_string_key *
+     ************************/
+
+    /**
+     * @class xinterned_string_key
+     * @brief Lookup key of an interned string.
+     *
+     * The xinterned_string_key is implicitly built from strings with
+     * xinterned_string::lookup, so that a string that was never
+     * interned does not grow the pool, and from interned strings.
+     */
+    class xinterned_string_key
+    {
+    public:
+
+        xinterned_string_key(const char* str);
+        xinterned_string_key(const std::string& str);
+        xinterned_string_key(const xinterned_string& str) noexcept;
+
+        operator const xinterned_string&() const noexcept;
+
+    private:
+
+        xinterned_string m_str;
+    };
+
+    bool operator==(const xinterned_string& lhs, const xinterned_string& rhs) noexcept;
+    bool operator!=(const xinterned_string& lhs, const xinterned_string& rhs) noexcept;
+    bool operator<(const xinterned_string& lhs, const xinterned_string& rhs) noexcept;
+    bool operator<=(const xinterned_string& lhs, const xinterned_string& rhs) noexcept;
+    bool operator>(const xinterned_string& lhs, const xinterned_string& rhs) noexcept;
+    bool operator>=(const xinterned_string& lhs, const xinterned_string& rhs) noexcept;
+
+    std::ostream& operator<<(std::ostream& out, const xinterned_string& str);
+
+    /*******************************
+     * xstring_pool implementation *
+     *******************************/
+
+    /**
+     * Returns the global pool of interned strings.
+     */
+    inline xstring_pool& xstring_pool::instance()
+    {
+        static xstring_pool pool;
+        return pool;
+    }
+
+    inline xstring_pool::xstring_pool()
+        : m_ids(), m_chunks(), m_size(0), m_mutex()
+    {
+        for (auto& c : m_chunks)
+        {
+            c.store(nullptr, std::memory_order_relaxed);
+        }
+        // Reserves the id 0 for the empty string so that default
+        // constructed labels do not need to lock the pool.
+        intern_impl(std::string());
+    }
+
+    inline xstring_pool::~xstring_pool()
+    {
+        for (auto& c : m_chunks)
+        {
+            delete[] c.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Returns the id of the specified string, adding it to the pool if
+     * it was not already interned.
+     * @throw std::length_error if the pool is full.
+     */
+    inline auto xstring_pool::intern(const std::string& str) -> id_type
+    {
+        return intern_impl(str);
+    }
+
+    /**
+     * Returns the id of the specified string, moving it to the pool if
+     * it was not already interned.
+     * @throw std::length_error if the pool is full.
+     */
+    inline auto xstring_pool::intern(std::string&& str) -> id_type
+    {
+        return intern_impl(std::move(str));
+    }
+
+    /**
+     * Returns the id of the specified string, or \c invalid_id if it
+     * was not interned. The pool is not modified.
+     */
+    inline auto xstring_pool::find(const std::string& str) const -> id_type
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+        auto it = m_ids.find(str);
+        return it != m_ids.end() ? it->second : invalid_id;
+    }
+
+    /**
+     * Returns the string of the specified id. The string of \c invalid_id
+     * is empty.
+     */
+    inline const std::string& xstring_pool::str(id_type id) const noexcept
+    {
+        if (id == invalid_id)
+        {
+            id = id_type(0);
+        }
+        const chunk_type* chunk = m_chunks[id >> chunk_bits].load(std::memory_order_acquire);
+        return *chunk[id & chunk_mask];
+    }
+
+    /**
+     * Returns the number of strings in the pool.
+     */
+    inline auto xstring_pool::size() const -> size_type
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+        return m_size;
+    }
+
+    template <class S>
+    inline auto xstring_pool::intern_impl(S&& str) -> id_type
+    {
+        // Strings already interned do not serialize on the exclusive lock.
+        id_type known = find(str);
+        if (known != invalid_id)
+        {
+            return known;
+        }
+        std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+        auto it = m_ids.find(str);
+        if (it != m_ids.end())
+        {
+            return it->second;
+        }
+        if (m_size == max_chunks * chunk_size)
+        {
+            throw std::length_error("xstring_pool: too many interned strings");
+        }
+
+        size_type chunk_index = m_size >> chunk_bits;
+        chunk_type* chunk = m_chunks[chunk_index].load(std::memory_order_relaxed);
+        if (chunk == nullptr)
+        {
+            chunk = new chunk_type[chunk_size];
+            m_chunks[chunk_index].store(chunk, std::memory_order_release);
+        }
+
+        id_type id = static_cast<id_type>(m_size);
+        auto res = m_ids.emplace(std::forward<S>(str), id);
+        // Keys of an unordered_map never move, the chunks point to them.
+        chunk[m_size & chunk_mask] = &(res.first->first);
+        ++m_size;
+        return id;
+    }
+
+    /***********************************
+     * xinterned_string implementation *
+     ***********************************/
+
+    /**
+     * Constructs an empty string.
+     */
+    inline xinterned_string::xinterned_string()
+        : m_id(0)
+    {
+        // Ensures the pool outlives the static labels built after it.
+        xstring_pool::instance();
+    }
+
+    /**
+     * Interns the specified string.
+     */
+    inline xinterned_string::xinterned_string(const char* str)
+        : m_id(xstring_pool::instance().intern(std::string(str)))
+    {
+    }
+
+    /**
+     * Interns the specified string.
+     */
+    inline xinterned_string::xinterned_string(const std::string& str)
+        : m_id(xstring_pool::instance().intern(str))
+    {
+    }
+
+    /**
+     * Interns the specified string.
+     */
+    inline xinterned_string::xinterned_string(std::string&& str)
+        : m_id(xstring_pool::instance().intern(std::move(str)))
+    {
+    }
+
+    /**
+     * Returns the key of the specified string for lookups, without interning
+     * it. If the string is not interned, the key is invalid and differs from
+     * every interned string.
+     */
+    inline xinterned_string xinterned_string::lookup(const char* str)
+    {
+        return lookup(std::string(str));
+    }
+
+    /**
+     * Returns the key of the specified string for lookups, without interning
+     * it. If the string is not interned, the key is invalid and differs from
+     * every interned string.
+     */
+    inline xinterned_string xinterned_string::lookup(const std::string& str)
+    {
+        return from_id(xstring_pool::instance().find(str));
+    }
+
+    /**
+     * Returns the interned string.
+     */
+    inline const std::string& xinterned_string::str() const noexcept
+    {
+        return xstring_pool::instance().str(m_id);
+    }
+
+    /**
+     * Returns a pointer to the null-terminated characters of the string.
+     */
+    inline const char* xinterned_string::c_str() const noexcept
+    {
+        return str().c_str();
+    }
+
+    /**
+     * Returns the number of characters of the string.
+     */
+    inline auto xinterned_string::size() const noexcept -> size_type
+    {
+        return str().size();
+    }
+
+    /**
+     * Returns true if the string is empty.
+     */
+    inline bool xinterned_string::empty() const noexcept
+    {
+        return m_id == id_type(0);
+    }
+
+    /**
+     * Returns the id of the string in the global pool.
+     */
+    inline auto xinterned_string::id() const noexcept -> id_type
+    {
+        return m_id;
+    }
+
+    /**
+     * Returns false if the string is a lookup key of a string that was not
+     * interned.
+     */
+    inline bool xinterned_string::valid() const noexcept
+    {
+        return m_id != xstring_pool::invalid_id;
+    }
+
+    inline xinterned_string xinterned_string::from_id(id_type id) noexcept
+    {
+        xinterned_string res;
+        res.m_id = id;
+        return res;
+    }
+
+    inline bool operator==(const xinterned_string& lhs, const xinterned_string& rhs) noexcept
+    {
+        return lhs.id() == rhs.id();
+    }
+
+    inline bool operator!=(const xinterned_string& lhs, const xinterned_string& rhs) noexcept
+    {
+        return lhs.id() != rhs.id();
+    }
+
+    // An invalid key has an empty string; the ids keep it distinct from
+    // the interned empty string.
+    inline bool operator<(const xinterned_string& lhs, const xinterned_string& rhs) noexcept
+    {
+        if (lhs.id() == rhs.id())
+        {
+            return false;
+        }
+        int cmp = lhs.str().compare(rhs.str());
+        return cmp < 0 || (cmp == 0 && lhs.id() < rhs.id());
+    }
+
+    inline bool operator<=(const xinterned_string& lhs, const xinterned_string& rhs) noexcept
+    {
+        return !(rhs < lhs);
+    }
+
+    inline bool operator>(const xinterned_string& lhs, const xinterned_string& rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+
+    inline bool operator>=(const xinterned_string& lhs, const xinterned_string& rhs) noexcept
+    {
+        return !(lhs < rhs);
+    }
+
+    inline std::ostream& operator<<(std::ostream& out, const xinterned_string& str)
+    {
+        return out << str.str();
+    }
+
+    /***************************************
+     * xinterned_string_key implementation *
+     ***************************************/
+
+    inline xinterned_string_key::xinterned_string_key(const char* str)
+        : m_str(xinterned_string::lookup(str))
+    {
+    }
+
+    inline xinterned_string_key::xinterned_string_key(const std::string& str)
+        : m_str(xinterned_string::lookup(str))
+    {
+    }
+
+    inline xinterned_string_key::xinterned_string_key(const xinterned_string& str) noexcept
+        : m_str(str)
+    {
+    }
+
+    /**
+     * Returns the interned string, or an invalid key if the string
+     * was not interned.
+     */
+    inline xinterned_string_key::operator const xinterned_string&() const noexcept
+    {
+        return m_str;
+    }
+}
+
+namespace std
+{
+    template <>
+    struct hash<xf::xinterned_string>
+    {
+        std::size_t operator()(const xf::xinterned_string& str) const noexcept
+        {
+            return std::hash<xf::xinterned_string::id_type>()(str.id());
+        }
+    };
+}
+
+#endif
@@ -55,7 +55,7 @@ namespace xf
 
         const name_type& name() const & noexcept;
         const axis_variant_type& axis() const & noexcept;
-        const value_type& label(size_type i) const & noexcept;
+        value_type label(size_type i) const;
 
     private:
 
@@ -118,7 +118,7 @@ namespace xf
      * @return the label at the given position of the underlying xaxis.
      */
     template <class K, class T, class MT, class L, class LT>
-    inline auto xnamed_axis<K, T, MT, L, LT>::label(size_type i) const & noexcept -> const LT&
+    inline auto xnamed_axis<K, T, MT, L, LT>::label(size_type i) const -> value_type
     {
         return get_labels<LT>(m_axis)[i];
     }
@@ -158,7 +158,7 @@ namespace xf
     }
 
     template <class LB, class K, class T, class MT = hash_map_tag, class L = XFRAME_DEFAULT_LABEL_LIST>
-    auto get_labels(const xnamed_axis<K, T, MT, L, LB>& n_axis) -> const typename xaxis<LB, T, MT>::label_list&
+    auto get_labels(const xnamed_axis<K, T, MT, L, LB>& n_axis) -> detail::xaxis_label_range<LB>
     {
         return get_labels<LB>(n_axis.axis());
     }
@@ -13,12 +13,85 @@
 
 #include "xtensor/xexpression.hpp"
 
+#include "xbroadcast_plan.hpp"
 #include "xcoordinate_chain.hpp"
 #include "xreindex_data.hpp"
 #include "xvariable.hpp"
 
 namespace xf
 {
+    namespace detail
+    {
+        /********************
+         * xreindex_indexer *
+         ********************/
+
+        // Maps the positions of a reindexed axis to the positions of the
+        // initial axis, or -1 for the labels missing in the initial axis.
+        // Axes whose labels form a single run of the initial axis (same
+        // axis, slice, prefix or suffix) only store the offset of the run.
+        class xreindex_indexer
+        {
+        public:
+
+            using size_type = std::size_t;
+
+            xreindex_indexer() noexcept;
+
+            template <class A>
+            xreindex_indexer(const A& new_axis, const A& initial_axis);
+
+            bool is_identity() const noexcept;
+            bool is_contiguous() const noexcept;
+
+            std::ptrdiff_t operator[](size_type i) const noexcept;
+
+        private:
+
+            position_remap m_positions;
+            std::ptrdiff_t m_offset;
+        };
+
+        inline xreindex_indexer::xreindex_indexer() noexcept
+            : m_positions(), m_offset(0)
+        {
+        }
+
+        template <class A>
+        inline xreindex_indexer::xreindex_indexer(const A& new_axis, const A& initial_axis)
+            : m_positions(build_position_remap(new_axis, initial_axis)), m_offset(0)
+        {
+            if (!m_positions.empty() && m_positions.front() >= 0)
+            {
+                std::ptrdiff_t offset = m_positions.front();
+                bool contiguous = true;
+                for (size_type i = 1; contiguous && i < m_positions.size(); ++i)
+                {
+                    contiguous = m_positions[i] == offset + static_cast<std::ptrdiff_t>(i);
+                }
+                if (contiguous)
+                {
+                    m_positions.clear();
+                    m_offset = offset;
+                }
+            }
+        }
+
+        inline bool xreindex_indexer::is_identity() const noexcept
+        {
+            return m_positions.empty() && m_offset == 0;
+        }
+
+        inline bool xreindex_indexer::is_contiguous() const noexcept
+        {
+            return m_positions.empty();
+        }
+
+        inline std::ptrdiff_t xreindex_indexer::operator[](size_type i) const noexcept
+        {
+            return m_positions.empty() ? static_cast<std::ptrdiff_t>(i) + m_offset : m_positions[i];
+        }
+    }
 
     /*****************
      * xreindex_view *
@@ -124,6 +197,7 @@ namespace xf
     private:
 
         void init_shape();
+        void init_indexers();
 
         template <std::size_t N, class IDX>
         const_reference element_impl(IDX&& index) const;
@@ -147,6 +221,7 @@ namespace xf
         coordinate_type m_coordinate;
         const dimension_type& m_dimension_mapping;
         shape_type m_shape;
+        std::vector<detail::xreindex_indexer> m_indexers;
         data_type m_data;
     };
 
@@ -169,6 +244,9 @@ namespace xf
     template <class Join, class E1, class... E>
     auto align(E1&& e1, E&&... e);
 
+    template <class Join, class E1, class... E>
+    auto align_copy(const E1& e1, const E&... e);
+
     /********************************
      * xreindex_view implementation *
      ********************************/
@@ -178,6 +256,7 @@ namespace xf
         : m_e(std::forward<decltype(rhs.m_e)>(rhs.m_e)),
           m_coordinate(std::move(rhs.m_coordinate)),
           m_dimension_mapping(m_e.dimension_mapping()),
+          m_indexers(std::move(rhs.m_indexers)),
           m_data(*this)
     {
         init_shape();
@@ -188,6 +267,7 @@ namespace xf
         : m_e(rhs.m_e),
           m_coordinate(rhs.m_coordinate),
           m_dimension_mapping(m_e.dimension_mapping()),
+          m_indexers(rhs.m_indexers),
           m_data(*this)
     {
         init_shape();
@@ -202,6 +282,7 @@ namespace xf
           m_data(*this)
     {
         init_shape();
+        init_indexers();
     }
 
     template <class CT>
@@ -213,6 +294,7 @@ namespace xf
           m_data(*this)
     {
         init_shape();
+        init_indexers();
     }
 
     template <class CT>
@@ -371,32 +453,42 @@ namespace xf
         }
     }
 
+    template <class CT>
+    inline void xreindex_view<CT>::init_indexers()
+    {
+        size_type dim = dimension();
+        m_indexers.resize(dim);
+        const auto& reindex_map = m_coordinate.reindex_map();
+        for (size_type i = 0; i < dim; ++i)
+        {
+            const auto& dim_name = dimension_labels()[i];
+            auto iter = reindex_map.find(dim_name);
+            if (iter != reindex_map.end())
+            {
+                m_indexers[i] = detail::xreindex_indexer(iter->second, m_coordinate.initial_coordinates()[dim_name]);
+            }
+        }
+    }
+
     template <class CT>
     template <std::size_t N, class IDX>
     inline auto xreindex_view<CT>::element_impl(IDX&& index) const -> const_reference
     {
-        bool contained = true;
-        for(std::size_t i = 0; i < index.size(); ++i)
+        std::decay_t<IDX> idx(std::forward<IDX>(index));
+        for (std::size_t i = 0; i < idx.size(); ++i)
         {
-            auto dim_name = m_dimension_mapping.label(i);
-            auto iter = m_coordinate.reindex_map().find(dim_name);
-            if(iter != m_coordinate.reindex_map().end())
+            const auto& indexer = m_indexers[i];
+            if (!indexer.is_identity())
             {
-                auto label = (iter->second).label(index[i]);
-                auto subiter = m_coordinate.initial_coordinates().find(dim_name);
-                auto subindex = (subiter->second).find(label);
-                if(subindex == (subiter->second).end())
+                std::ptrdiff_t pos = indexer[static_cast<size_type>(idx[i])];
+                if (pos < 0)
                 {
-                    contained = false;
-                    break;
-                }
-                else
-                {
-                    index[i] = subindex->second;
+                    return missing();
                 }
+                idx[i] = static_cast<typename std::decay_t<IDX>::value_type>(pos);
             }
         }
-        return contained ? m_e.template element<N>(std::forward<IDX>(index)) : missing();
+        return m_e.template element<N>(std::move(idx));
     }
 
     template <class CT>
@@ -406,8 +498,9 @@ namespace xf
         for(std::size_t i = 0; i < locator.size(); ++i)
         {
             auto dim_name = m_dimension_mapping.label(i);
-            bool contained = m_coordinate.is_reindexed(dim_name, locator[i]);
-            bool sub_contained = m_coordinate.initial_coordinates().contains(dim_name, locator[i]);
+            const auto& label = detail::label_variant_cast<typename coordinate_type::label_type>(locator[i]);
+            bool contained = m_coordinate.is_reindexed(dim_name, label);
+            bool sub_contained = m_coordinate.initial_coordinates().contains(dim_name, label);
             if(contained && !sub_contained)
             {
                 return missing();
@@ -422,8 +515,9 @@ namespace xf
     {
         for(const auto& c: selector)
         {
-            bool contained = m_coordinate.is_reindexed(c.first, c.second);
-            bool sub_contained = m_e.coordinates().contains(c.first, c.second);
+            const auto& label = detail::label_variant_cast<typename coordinate_type::label_type>(c.second);
+            bool contained = m_coordinate.is_reindexed(c.first, label);
+            bool sub_contained = m_e.coordinates().contains(c.first, label);
             if(contained && !sub_contained)
             {
                 return missing();
@@ -458,29 +552,16 @@ namespace xf
     inline auto xreindex_view<CT>::build_iselect_index(S&& selector) const -> std::pair<index_type<N>, bool>
     {
         auto res = std::make_pair(xtl::make_sequence<index_type<N>>(dimension(), size_type(0)), true);
-        auto reindex_end = m_coordinate.reindex_map().end();
         for(const auto& c: selector)
         {
-            auto iter = m_coordinate.reindex_map().find(c.first);
-            if(iter != reindex_end)
+            size_type dim_index = m_dimension_mapping[c.first];
+            std::ptrdiff_t pos = m_indexers[dim_index][static_cast<size_type>(c.second)];
+            if(pos < 0)
             {
-                auto label = (iter->second).label(c.second);
-                auto subiter = m_coordinate.initial_coordinates().find(c.first);
-                auto subindex = (subiter->second).find(label);
-                if(subindex == (subiter->second).end())
-                {
-                    res.second = false;
-                    break;
-                }
-                else
-                {
-                    res.first[m_dimension_mapping[c.first]] = subindex->second;
-                }
-            }
-            else
-            {
-                res.first[m_dimension_mapping[c.first]] = c.second;
+                res.second = false;
+                break;
             }
+            res.first[dim_index] = static_cast<size_type>(pos);
         }
         return res;
     }
@@ -539,6 +620,54 @@ namespace xf
                                detail::reindex_like_coord(std::forward<E>(e), coord)...);
     }
 
+    namespace detail
+    {
+        template <class E, class C>
+        inline auto align_copy_coord(const E& e, const C& coords)
+        {
+            using result_type = typename E::temporary_type;
+            using coordinate_type = typename result_type::coordinate_type;
+            using coordinate_map = typename coordinate_type::map_type;
+
+            if (e.coordinates() == coords)
+            {
+                return result_type(e);
+            }
+
+            coordinate_map new_coord;
+            for (const auto& name : e.dimension_labels())
+            {
+                new_coord.insert(std::make_pair(name, coords[name]));
+            }
+            result_type res;
+            res.resize(coordinate_type(std::move(new_coord)), e.dimension_mapping());
+            xt::xexpression_assigner<xvariable_expression_tag>::assign_data(res, e, false);
+            return res;
+        }
+    }
+
+    /**
+     * Aligns the specified variables and returns dense copies of the result.
+     *
+     * Unlike align, which returns views translating labels on each access,
+     * align_copy computes the joined coordinates once and gathers each
+     * variable into new storage, missing labels being set to missing
+     * values. Operations on the returned variables then take the trivial
+     * broadcasting path.
+     * @tparam Join the join applied to the coordinates.
+     * @param e1 the first variable to align.
+     * @param e the other variables to align.
+     * @return a tuple of variables sharing the same coordinates.
+     */
+    template <class Join, class E1, class... E>
+    inline auto align_copy(const E1& e1, const E&... e)
+    {
+        auto coord = e1.coordinates();
+        broadcast_coordinates<Join>(coord, e.coordinates()...);
+        return std::make_tuple(detail::align_copy_coord(e1, coord),
+                               detail::align_copy_coord(e, coord)...);
+    }
+
     template <class CT>
     inline std::ostream& operator<<(std::ostream& out, const xreindex_view<CT>& view)
     {
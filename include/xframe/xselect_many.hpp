@@ -0,0 +1,237 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XFRAME_XSELECT_MANY_HPP
+#define XFRAME_XSELECT_MANY_HPP
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include "xtensor/xoptional_assembly.hpp"
+#include "xtensor/xtensor.hpp"
+
+#include "xcompiled_locator.hpp"
+#include "xvariable_reducer.hpp"
+
+namespace xf
+{
+    /***************
+     * select_many *
+     ***************/
+
+    template <class CCT, class ECT>
+    using xselect_many_label_column = typename xvariable_container<CCT, ECT>::coordinate_type::axis_type::label_list;
+
+    template <class CCT, class ECT>
+    using xselect_many_labels = std::map<typename xvariable_container<CCT, ECT>::key_type,
+                                         xselect_many_label_column<CCT, ECT>>;
+
+    template <class CCT, class ECT>
+    using xselect_many_positions = std::map<typename xvariable_container<CCT, ECT>::key_type,
+                                            std::reference_wrapper<const std::vector<std::size_t>>>;
+
+    namespace detail
+    {
+        template <class V>
+        using xselect_many_result_t = xt::xoptional_assembly<xt::xtensor<xreducer_value_type_t<V>, 1>,
+                                                             xt::xtensor<bool, 1>>;
+    }
+
+    template <class Join = XFRAME_DEFAULT_JOIN, class CCT, class ECT>
+    auto select_many(const xvariable_container<CCT, ECT>& v, const xselect_many_labels<CCT, ECT>& columns);
+
+    template <class CCT, class ECT>
+    auto iselect_many(const xvariable_container<CCT, ECT>& v, const xselect_many_positions<CCT, ECT>& columns);
+
+    /******************************
+     * select_many implementation *
+     ******************************/
+
+    namespace detail
+    {
+        constexpr std::size_t select_many_npos = std::numeric_limits<std::size_t>::max();
+
+        template <class C>
+        inline std::size_t select_many_column_size(const C& column)
+        {
+            return column.size();
+        }
+
+        inline std::size_t select_many_column_size(const std::reference_wrapper<const std::vector<std::size_t>>& column)
+        {
+            return column.get().size();
+        }
+
+        // Checks that all the dimensions are specified and that the columns
+        // have the same length, and returns this length.
+        template <class V, class M>
+        inline std::size_t check_select_many_columns(const V& v, const M& columns)
+        {
+            if (columns.size() != v.dimension())
+            {
+                throw std::invalid_argument("select_many requires all the dimensions of the variable");
+            }
+            std::size_t size = columns.empty() ? std::size_t(0) : select_many_column_size(columns.cbegin()->second);
+            for (const auto& c : columns)
+            {
+                if (select_many_column_size(c.second) != size)
+                {
+                    throw std::invalid_argument("select_many requires columns of the same length");
+                }
+            }
+            return size;
+        }
+
+        // Adds the contribution of a column of labels to the offsets. The
+        // typed axis is resolved once for the whole column, each label then
+        // costs a single lookup.
+        template <class Join, class A, class L>
+        inline void select_many_column(const A& axis, const std::vector<L>& labels, std::size_t stride,
+                                       std::vector<std::size_t>& offsets)
+        {
+            using builder_type = xlocator_axis_builder<L, typename A::mapped_type, typename A::map_container_tag>;
+            auto cache = xtl::visit(builder_type(), axis.storage());
+            const std::size_t size = axis.size();
+            for (std::size_t i = 0; i < labels.size(); ++i)
+            {
+                std::size_t pos = cache.find(labels[i]);
+                if (pos == size)
+                {
+                    if (Join::id() == join::inner::id())
+                    {
+                        throw std::out_of_range("select_many: label not found");
+                    }
+                    offsets[i] = select_many_npos;
+                }
+                else if (offsets[i] != select_many_npos)
+                {
+                    offsets[i] += pos * stride;
+                }
+            }
+        }
+
+        template <class V>
+        inline auto select_many_gather(const V& v, const std::vector<std::size_t>& offsets)
+        {
+            using result_type = xselect_many_result_t<V>;
+            using value_type = xreducer_value_type_t<V>;
+
+            typename result_type::shape_type shape = { offsets.size() };
+            result_type res(shape);
+            value_type* res_values = res.value().data();
+            auto& res_mask = res.has_value().storage();
+
+            const value_type* values = v.data().value().data();
+            const auto& mask = v.data().has_value().storage();
+            for (std::size_t i = 0; i < offsets.size(); ++i)
+            {
+                std::size_t offset = offsets[i];
+                if (offset == select_many_npos)
+                {
+                    res_values[i] = value_type();
+                    res_mask[i] = false;
+                }
+                else
+                {
+                    res_values[i] = values[offset];
+                    res_mask[i] = mask[offset];
+                }
+            }
+            return res;
+        }
+    }
+
+    /**
+     * Selects many elements of a variable at once, given a column of labels
+     * per dimension. The i-th element of the result is the element whose
+     * labels are the i-th labels of the columns.
+     *
+     * Dimension names and typed axes are resolved once per column, so that
+     * each label costs a single lookup in its axis.
+     *
+     * The columns are held by reference and must outlive the call.
+     * @tparam Join the join policy applied to labels that are not found:
+     * \c join::inner throws, \c join::outer returns a missing value.
+     * @param v the variable to select from.
+     * @param columns a map from the names of the dimensions to the columns
+     * of labels. All the dimensions of the variable must be specified.
+     * @return a one-dimensional optional assembly holding the selected
+     * elements.
+     * @throw std::invalid_argument if a dimension is not specified, if the
+     * columns do not have the same length, or if the type of a column
+     * does not match the label type of its axis.
+     * @throw std::out_of_range if a label is not found and \c Join is
+     * \c join::inner.
+     */
+    template <class Join, class CCT, class ECT>
+    inline auto select_many(const xvariable_container<CCT, ECT>& v, const xselect_many_labels<CCT, ECT>& columns)
+    {
+        std::size_t size = detail::check_select_many_columns(v, columns);
+        std::vector<std::size_t> offsets(size, std::size_t(0));
+        const auto& strides = v.data().value().strides();
+        for (const auto& c : columns)
+        {
+            std::size_t dim = v.dimension_mapping()[c.first];
+            const auto& axis = v.coordinates()[c.first];
+            std::size_t stride = static_cast<std::size_t>(strides[dim]);
+            xtl::visit([&axis, stride, &offsets](const auto& labels)
+            {
+                detail::select_many_column<Join>(axis, detail::unwrap(labels), stride, offsets);
+            }, c.second.storage());
+        }
+        return detail::select_many_gather(v, offsets);
+    }
+
+    /**
+     * Selects many elements of a variable at once, given a column of
+     * positions per dimension. The i-th element of the result is the
+     * element whose positions are the i-th positions of the columns.
+     *
+     * The columns are held by reference and must outlive the call.
+     * @param v the variable to select from.
+     * @param columns a map from the names of the dimensions to the columns
+     * of positions. All the dimensions of the variable must be specified.
+     * @return a one-dimensional optional assembly holding the selected
+     * elements.
+     * @throw std::invalid_argument if a dimension is not specified, or if
+     * the columns do not have the same length.
+     * @throw std::out_of_range if a position exceeds the size of its axis.
+     */
+    template <class CCT, class ECT>
+    inline auto iselect_many(const xvariable_container<CCT, ECT>& v, const xselect_many_positions<CCT, ECT>& columns)
+    {
+        std::size_t size = detail::check_select_many_columns(v, columns);
+        std::vector<std::size_t> offsets(size, std::size_t(0));
+        const auto& shape = v.data().value().shape();
+        const auto& strides = v.data().value().strides();
+        for (const auto& c : columns)
+        {
+            std::size_t dim = v.dimension_mapping()[c.first];
+            std::size_t dim_size = static_cast<std::size_t>(shape[dim]);
+            std::size_t stride = static_cast<std::size_t>(strides[dim]);
+            const std::vector<std::size_t>& positions = c.second.get();
+            for (std::size_t i = 0; i < positions.size(); ++i)
+            {
+                if (positions[i] >= dim_size)
+                {
+                    throw std::out_of_range("iselect_many: position out of range");
+                }
+                offsets[i] += positions[i] * stride;
+            }
+        }
+        return detail::select_many_gather(v, offsets);
+    }
+}
+
+#endif
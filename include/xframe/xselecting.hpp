@@ -59,6 +59,20 @@ namespace xf
         {
             return static_missing_impl<T>::get();
         }
+
+        // Selectors and locators hold the lookup keys of the labels, so
+        // that the labels they are given are not registered.
+        template <class TL>
+        struct lookup_variant;
+
+        template <template <class...> class TL, class... L>
+        struct lookup_variant<TL<L...>>
+        {
+            using type = xtl::variant<lookup_type_t<L>...>;
+        };
+
+        template <class TL>
+        using lookup_variant_t = typename lookup_variant<TL>::type;
     }
 
     /*************
@@ -76,7 +90,7 @@ namespace xf
         using coordinate_type = C;
         using key_type = typename coordinate_type::key_type;
         using label_list = typename coordinate_type::label_list;
-        using mapped_type = mpl::cast_t<label_list, xtl::variant>;
+        using mapped_type = detail::lookup_variant_t<label_list>;
         using size_type = typename coordinate_type::index_type;
         using index_type = detail::xselector_sequence_t<size_type, N>;
         using outer_index_type = std::pair<index_type, bool>;
@@ -140,7 +154,7 @@ namespace xf
         using coordinate_type = C;
         using key_type = typename coordinate_type::key_type;
         using label_list = typename coordinate_type::label_list;
-        using mapped_type = mpl::cast_t<label_list, xtl::variant>;
+        using mapped_type = detail::lookup_variant_t<label_list>;
         using size_type = typename coordinate_type::index_type;
         using index_type = detail::xselector_sequence_t<size_type, N>;
         using dimension_type = D;
@@ -0,0 +1,330 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XFRAME_XTHREAD_POOL_HPP
+#define XFRAME_XTHREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace xf
+{
+    /****************
+     * xthread_pool *
+     ****************/
+
+    /**
+     * @class xthread_pool
+     * @brief Pool of threads used for parallel evaluation.
+     *
+     * The xthread_pool runs batches of independent tasks. The thread that
+     * submits a batch takes part in its evaluation, and idle threads pick
+     * the next pending task of the batch, so that faster threads take over
+     * the work of slower ones. Tasks submitted from a task of the pool are
+     * run sequentially.
+     */
+    class xthread_pool
+    {
+    public:
+
+        using size_type = std::size_t;
+
+        static xthread_pool& instance();
+
+        explicit xthread_pool(size_type nb_threads = 0);
+        ~xthread_pool();
+
+        xthread_pool(const xthread_pool&) = delete;
+        xthread_pool& operator=(const xthread_pool&) = delete;
+        xthread_pool(xthread_pool&&) = delete;
+        xthread_pool& operator=(xthread_pool&&) = delete;
+
+        size_type size() const noexcept;
+        void resize(size_type nb_threads);
+
+        template <class F>
+        void parallel_for(size_type nb_tasks, F&& f);
+
+        template <class F>
+        void parallel_for_range(size_type size, F&& f);
+
+    private:
+
+        using task_type = std::function<void(size_type)>;
+
+        static size_type default_size() noexcept;
+        static bool& in_pool() noexcept;
+
+        void start(size_type nb_threads);
+        void stop();
+
+        void worker_loop(size_type generation);
+        void run_tasks();
+
+        std::vector<std::thread> m_workers;
+        std::atomic<size_type> m_nb_workers;
+        std::mutex m_mutex;
+        std::mutex m_submit_mutex;
+        std::condition_variable m_start_cv;
+        std::condition_variable m_done_cv;
+        task_type m_task;
+        size_type m_nb_tasks;
+        std::atomic<size_type> m_next_task;
+        size_type m_nb_running;
+        size_type m_generation;
+        bool m_stop;
+        std::exception_ptr m_exception;
+    };
+
+    xthread_pool::size_type assign_thread_count() noexcept;
+    void set_assign_thread_count(xthread_pool::size_type nb_threads);
+
+    /*******************************
+     * xthread_pool implementation *
+     *******************************/
+
+    /**
+     * Returns the pool used for parallel assignment. Its size defaults to
+     * the number of hardware threads.
+     */
+    inline xthread_pool& xthread_pool::instance()
+    {
+        static xthread_pool pool;
+        return pool;
+    }
+
+    /**
+     * Builds a pool of the specified size.
+     * @param nb_threads the number of threads evaluating the tasks, including
+     * the submitting thread. 0 stands for the number of hardware threads.
+     */
+    inline xthread_pool::xthread_pool(size_type nb_threads)
+        : m_workers(), m_nb_workers(0), m_task(), m_nb_tasks(0), m_next_task(0),
+          m_nb_running(0), m_generation(0), m_stop(false), m_exception()
+    {
+        start(nb_threads);
+    }
+
+    inline xthread_pool::~xthread_pool()
+    {
+        stop();
+    }
+
+    /**
+     * Returns the number of threads evaluating the tasks, including the
+     * submitting thread.
+     */
+    inline auto xthread_pool::size() const noexcept -> size_type
+    {
+        return m_nb_workers.load() + 1;
+    }
+
+    /**
+     * Changes the number of threads of the pool.
+     * @param nb_threads the number of threads evaluating the tasks, including
+     * the submitting thread. 0 stands for the number of hardware threads.
+     */
+    inline void xthread_pool::resize(size_type nb_threads)
+    {
+        std::lock_guard<std::mutex> submit_lock(m_submit_mutex);
+        stop();
+        start(nb_threads);
+    }
+
+    /**
+     * Calls f(i) for each i in [0, nb_tasks) and waits for all the calls to
+     * complete. If a call throws, the remaining tasks are skipped and the
+     * first exception is rethrown.
+     */
+    template <class F>
+    inline void xthread_pool::parallel_for(size_type nb_tasks, F&& f)
+    {
+        if (nb_tasks == 0)
+        {
+            return;
+        }
+        auto run_sequential = [nb_tasks, &f]()
+        {
+            for (size_type i = 0; i < nb_tasks; ++i)
+            {
+                f(i);
+            }
+        };
+        if (nb_tasks == 1 || in_pool())
+        {
+            run_sequential();
+            return;
+        }
+
+        // The workers are only read under the submit lock, resize may
+        // change them concurrently otherwise.
+        std::unique_lock<std::mutex> submit_lock(m_submit_mutex);
+        if (m_workers.empty())
+        {
+            submit_lock.unlock();
+            run_sequential();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task = [&f](size_type i) { f(i); };
+            m_nb_tasks = nb_tasks;
+            m_next_task.store(0);
+            m_nb_running = m_workers.size();
+            m_exception = nullptr;
+            ++m_generation;
+        }
+        m_start_cv.notify_all();
+        run_tasks();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done_cv.wait(lock, [this]() { return m_nb_running == 0; });
+        m_task = nullptr;
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+    /**
+     * Splits [0, size) into contiguous chunks and calls f(begin, end) on
+     * each of them. The chunks are smaller than size / this->size() so
+     * that idle threads can balance the load.
+     */
+    template <class F>
+    inline void xthread_pool::parallel_for_range(size_type size, F&& f)
+    {
+        size_type nb_tasks = std::min(size, 4 * this->size());
+        parallel_for(nb_tasks, [size, nb_tasks, &f](size_type i)
+        {
+            f(i * size / nb_tasks, (i + 1) * size / nb_tasks);
+        });
+    }
+
+    inline auto xthread_pool::default_size() noexcept -> size_type
+    {
+        size_type res = std::thread::hardware_concurrency();
+        return res == 0 ? size_type(1) : res;
+    }
+
+    inline bool& xthread_pool::in_pool() noexcept
+    {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    inline void xthread_pool::start(size_type nb_threads)
+    {
+        size_type size = nb_threads == 0 ? default_size() : nb_threads;
+        m_stop = false;
+        m_workers.reserve(size - 1);
+        // No batch is running here, new workers wait for the next one.
+        size_type generation = m_generation;
+        for (size_type i = 1; i < size; ++i)
+        {
+            m_workers.emplace_back([this, generation]() { worker_loop(generation); });
+        }
+        m_nb_workers.store(m_workers.size());
+    }
+
+    inline void xthread_pool::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_start_cv.notify_all();
+        for (auto& w : m_workers)
+        {
+            w.join();
+        }
+        m_workers.clear();
+        m_nb_workers.store(0);
+    }
+
+    inline void xthread_pool::worker_loop(size_type generation)
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_start_cv.wait(lock, [this, generation]() { return m_stop || m_generation != generation; });
+                if (m_stop)
+                {
+                    return;
+                }
+                generation = m_generation;
+            }
+            run_tasks();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_nb_running == 0)
+                {
+                    m_done_cv.notify_one();
+                }
+            }
+        }
+    }
+
+    inline void xthread_pool::run_tasks()
+    {
+        bool& flag = in_pool();
+        bool previous = flag;
+        flag = true;
+        size_type i = m_next_task.fetch_add(1);
+        while (i < m_nb_tasks)
+        {
+            try
+            {
+                m_task(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_exception)
+                {
+                    m_exception = std::current_exception();
+                }
+                m_next_task.store(m_nb_tasks);
+            }
+            i = m_next_task.fetch_add(1);
+        }
+        flag = previous;
+    }
+
+    /**
+     * Returns the number of threads used by parallel assignment.
+     * @sa XFRAME_ENABLE_PARALLEL_ASSIGN
+     */
+    inline xthread_pool::size_type assign_thread_count() noexcept
+    {
+        return xthread_pool::instance().size();
+    }
+
+    /**
+     * Sets the number of threads used by parallel assignment.
+     * @param nb_threads the number of threads; 0 stands for the number of
+     * hardware threads, 1 disables parallel assignment.
+     * @sa XFRAME_ENABLE_PARALLEL_ASSIGN
+     */
+    inline void set_assign_thread_count(xthread_pool::size_type nb_threads)
+    {
+        xthread_pool::instance().resize(nb_threads);
+    }
+}
+
+#endif
@@ -13,6 +13,7 @@
 
 #include "xtensor/xoptional_assembly.hpp"
 
+#include "xcompiled_locator.hpp"
 #include "xvariable_assign.hpp"
 #include "xvariable_base.hpp"
 #include "xvariable_math.hpp"
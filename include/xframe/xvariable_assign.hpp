@@ -11,10 +11,131 @@
 #ifndef XFRAME_XVARIABLE_ASSIGN_HPP
 #define XFRAME_XVARIABLE_ASSIGN_HPP
 
+#include "xtl/xoptional.hpp"
+#include "xtl/xtype_traits.hpp"
+
 #include "xtensor/xassign.hpp"
+#include "xtensor/xoperation.hpp"
+#include "xtensor/xoptional.hpp"
+#include "xframe_config.hpp"
+#include "xbitset_mask.hpp"
+#include "xbroadcast_plan.hpp"
 #include "xcoordinate.hpp"
 #include "xframe_expression.hpp"
 
+#if XFRAME_ENABLE_PARALLEL_ASSIGN
+#include "xtensor/xbroadcast.hpp"
+#include "xtensor/xnoalias.hpp"
+#include "xtensor/xview.hpp"
+#include "xthread_pool.hpp"
+#endif
+
+namespace xf
+{
+    namespace detail
+    {
+        /**********************
+         * bitset mask leaves *
+         **********************/
+
+        // The missing mask of an expression whose leaves all have bitset
+        // masks is the intersection of these masks, computed one block of
+        // 64 elements at a time.
+
+        template <class E>
+        struct xbitset_mask_leaves : std::false_type
+        {
+        };
+
+        template <class CCT, class ECT>
+        struct xbitset_mask_leaves<xvariable_container<CCT, ECT>>
+            : has_bitset_mask<typename xvariable_container<CCT, ECT>::data_type>
+        {
+        };
+
+        template <class CT>
+        struct xbitset_mask_leaves<xvariable_scalar<CT>> : std::true_type
+        {
+        };
+
+        // Only the element-wise operators whose result is missing as soon as
+        // one of their operands is missing can intersect the masks of their
+        // leaves. Other functors, such as the conditional of where, pick their
+        // result from a single operand and go through the optional assignment.
+
+        template <class F>
+        struct xbitset_mask_functor
+            : xtl::disjunction<std::is_same<F, xt::detail::identity>,
+                               std::is_same<F, xt::detail::negate>,
+                               std::is_same<F, xt::detail::plus>,
+                               std::is_same<F, xt::detail::minus>,
+                               std::is_same<F, xt::detail::multiplies>,
+                               std::is_same<F, xt::detail::divides>,
+                               std::is_same<F, xt::detail::modulus>,
+                               std::is_same<F, xt::detail::logical_or>,
+                               std::is_same<F, xt::detail::logical_and>,
+                               std::is_same<F, xt::detail::logical_not>,
+                               std::is_same<F, xt::detail::equal_to>,
+                               std::is_same<F, xt::detail::not_equal_to>,
+                               std::is_same<F, xt::detail::less>,
+                               std::is_same<F, xt::detail::less_equal>,
+                               std::is_same<F, xt::detail::greater>,
+                               std::is_same<F, xt::detail::greater_equal>>
+        {
+        };
+
+        template <class F, class R, class... CT>
+        struct xbitset_mask_leaves<xvariable_function<F, R, CT...>>
+            : xtl::conjunction<xbitset_mask_functor<F>, xbitset_mask_leaves<xdecay_variable_closure_t<CT>>...>
+        {
+        };
+
+        using xbitset_mask_storage = typename xbitset_mask::storage_type;
+
+        template <class T>
+        inline bool scalar_has_value(const T&) noexcept
+        {
+            return true;
+        }
+
+        template <class T, class B>
+        inline bool scalar_has_value(const xtl::xoptional<T, B>& v) noexcept
+        {
+            return v.has_value();
+        }
+
+        template <class CCT, class ECT>
+        inline void intersect_bitset_mask(xbitset_mask_storage& mask, const xvariable_container<CCT, ECT>& e)
+        {
+            mask &= e.data().has_value().storage();
+        }
+
+        template <class CT>
+        inline void intersect_bitset_mask(xbitset_mask_storage& mask, const xvariable_scalar<CT>& e)
+        {
+            if (!scalar_has_value(e.data()()))
+            {
+                mask.reset();
+            }
+        }
+
+        template <class F, class R, class... CT, std::size_t... I>
+        inline void intersect_bitset_mask_impl(xbitset_mask_storage& mask,
+                                               const xvariable_function<F, R, CT...>& e,
+                                               std::index_sequence<I...>)
+        {
+            using swallow = int[];
+            (void)swallow{0, (intersect_bitset_mask(mask, std::get<I>(e.arguments())), 0)...};
+        }
+
+        template <class F, class R, class... CT>
+        inline void intersect_bitset_mask(xbitset_mask_storage& mask, const xvariable_function<F, R, CT...>& e)
+        {
+            intersect_bitset_mask_impl(mask, e, std::make_index_sequence<sizeof...(CT)>());
+        }
+    }
+}
+
 namespace xt
 {
     using xvariable_expression_tag = xf::xvariable_expression_tag;
@@ -50,6 +171,33 @@ namespace xt
         template <class E1, class E2>
         static void assign_resized_xexpression(xexpression<E1>& e1, const xexpression<E2>& e2,
                                                xf::xtrivial_broadcast trivial);
+
+        template <class E1, class E2>
+        static void assign_data_impl(xexpression<E1>& e1, const xexpression<E2>& e2, std::true_type);
+
+        template <class E1, class E2>
+        static void assign_data_impl(xexpression<E1>& e1, const xexpression<E2>& e2, std::false_type);
+
+        template <class E1, class E2>
+        static void assign_plan(E1& d1, const xf::xbroadcast_plan<E2>& plan,
+                                std::size_t first, std::size_t last);
+
+        template <class E1, class E2>
+        static void assign_bitset_optional(E1& e1, const E2& e2, std::true_type);
+
+        template <class E1, class E2>
+        static void assign_bitset_optional(E1& e1, const E2& e2, std::false_type);
+
+#if XFRAME_ENABLE_PARALLEL_ASSIGN
+        template <class E1>
+        static bool use_parallel_assign(const E1& d1);
+
+        template <class D1, class D2>
+        static void parallel_assign_optional_tensor(D1& d1, const D2& d2, bool trivial);
+
+        template <class D1, class V2, class M2>
+        static void parallel_assign_chunks(D1& d1, const V2& value2, const M2& mask2);
+#endif
     };
 
     /***************************************
@@ -84,6 +232,67 @@ namespace xt
     inline void xexpression_assigner<xvariable_expression_tag>::assign_data(xexpression<E1>& e1,
                                                                             const xexpression<E2>& e2,
                                                                             bool /*trivial*/)
+    {
+        assign_data_impl(e1, e2, xf::has_broadcast_plan<E2>());
+    }
+
+    template <class E1, class E2>
+    inline void xexpression_assigner<xvariable_expression_tag>::assign_data_impl(xexpression<E1>& e1,
+                                                                                 const xexpression<E2>& e2,
+                                                                                 std::true_type)
+    {
+        E1& d1 = e1.derived_cast();
+        if (d1.data().size() == 0)
+        {
+            return;
+        }
+        xf::xbroadcast_plan<E2> plan(e2.derived_cast(), d1.coordinates(), d1.dimension_mapping());
+        std::size_t outer_size = d1.dimension() == 0 ? std::size_t(1) : d1.shape()[0];
+#if XFRAME_ENABLE_PARALLEL_ASSIGN
+        if (use_parallel_assign(d1))
+        {
+            // Copies of the plan share its remapping tables, each chunk
+            // only copies the scratch indices.
+            xf::xthread_pool::instance().parallel_for_range(outer_size, [&d1, &plan](std::size_t first, std::size_t last)
+            {
+                xf::xbroadcast_plan<E2> local_plan(plan);
+                assign_plan(d1, local_plan, first, last);
+            });
+            return;
+        }
+#endif
+        assign_plan(d1, plan, std::size_t(0), outer_size);
+    }
+
+    /**
+     * Assigns the elements of d1 whose outermost index is in [first, last).
+     */
+    template <class E1, class E2>
+    inline void xexpression_assigner<xvariable_expression_tag>::assign_plan(E1& d1,
+                                                                            const xf::xbroadcast_plan<E2>& plan,
+                                                                            std::size_t first,
+                                                                            std::size_t last)
+    {
+        using size_type = typename E1::size_type;
+        using index_type = typename E1::template index_type<>;
+        index_type index(d1.dimension(), size_type(0));
+        if (index.size() != 0)
+        {
+            index[0] = static_cast<size_type>(first);
+        }
+        bool end = first >= last;
+        while (!end)
+        {
+            d1.element(index) = plan.element(index);
+            end = detail::increment_index(d1.shape(), index) ||
+                (index.size() != 0 && static_cast<std::size_t>(index[0]) >= last);
+        }
+    }
+
+    template <class E1, class E2>
+    inline void xexpression_assigner<xvariable_expression_tag>::assign_data_impl(xexpression<E1>& e1,
+                                                                                 const xexpression<E2>& e2,
+                                                                                 std::false_type)
     {
         const auto& dim_label = e1.derived_cast().dimension_mapping().labels();
         const auto& coords = e1.derived_cast().coordinates();
@@ -181,11 +390,108 @@ namespace xt
                                                                                        const xexpression<E2>& e2,
                                                                                        bool trivial)
     {
+        using bitset_assign = xtl::conjunction<xf::has_bitset_mask<typename E1::data_type>,
+                                               xf::detail::xbitset_mask_leaves<E2>>;
+        if (trivial && bitset_assign::value)
+        {
+            assign_bitset_optional(e1.derived_cast(), e2.derived_cast(), bitset_assign());
+            return;
+        }
+#if XFRAME_ENABLE_PARALLEL_ASSIGN
+        if (use_parallel_assign(e1.derived_cast()))
+        {
+            parallel_assign_optional_tensor(e1.derived_cast().data(), e2.derived_cast().data(), trivial);
+            return;
+        }
+#endif
         xexpression_assigner<xoptional_expression_tag>::assign_data(e1.derived_cast().data(),
                                                                     e2.derived_cast().data(),
                                                                     trivial);
     }
 
+    /**
+     * Assigns an expression whose leaves have the same shape as e1 and bitset
+     * masks. The values are assigned by xtensor, the mask is the intersection
+     * of the masks of the leaves, computed one block at a time instead of one
+     * bit at a time.
+     */
+    template <class E1, class E2>
+    inline void xexpression_assigner<xvariable_expression_tag>::assign_bitset_optional(E1& e1,
+                                                                                       const E2& e2,
+                                                                                       std::true_type)
+    {
+        auto& d1 = e1.data();
+        xt::assign_data(d1.value(), xt::value(e2.data()), true);
+        // e1 may be a leaf of e2, its mask is replaced once all the leaves
+        // have been read.
+        xf::detail::xbitset_mask_storage mask(d1.size(), true);
+        xf::detail::intersect_bitset_mask(mask, e2);
+        d1.has_value().storage() = std::move(mask);
+    }
+
+    template <class E1, class E2>
+    inline void xexpression_assigner<xvariable_expression_tag>::assign_bitset_optional(E1&,
+                                                                                       const E2&,
+                                                                                       std::false_type)
+    {
+    }
+
+#if XFRAME_ENABLE_PARALLEL_ASSIGN
+    template <class E1>
+    inline bool xexpression_assigner<xvariable_expression_tag>::use_parallel_assign(const E1& d1)
+    {
+        // Bits of a bitset mask are not independent memory locations.
+        return !xf::has_bitset_mask<typename E1::data_type>::value &&
+            d1.dimension() != 0 &&
+            d1.data().size() >= std::size_t(XFRAME_PARALLEL_ASSIGN_THRESHOLD) &&
+            xf::assign_thread_count() > 1;
+    }
+
+    /**
+     * Assigns d2 to d1 by chunks of the outermost dimension. Like the sequential
+     * assignment of optional expressions, values and missing masks are assigned
+     * separately. Each element is computed by a single thread, the result does
+     * not depend on the number of threads.
+     */
+    template <class D1, class D2>
+    inline void xexpression_assigner<xvariable_expression_tag>::parallel_assign_optional_tensor(D1& d1,
+                                                                                                const D2& d2,
+                                                                                                bool trivial)
+    {
+        if (trivial)
+        {
+            parallel_assign_chunks(d1, xt::value(d2), xt::has_value(d2));
+        }
+        else
+        {
+            parallel_assign_chunks(d1, xt::broadcast(xt::value(d2), d1.shape()),
+                                   xt::broadcast(xt::has_value(d2), d1.shape()));
+        }
+    }
+
+    template <class D1, class V2, class M2>
+    inline void xexpression_assigner<xvariable_expression_tag>::parallel_assign_chunks(D1& d1,
+                                                                                       const V2& value2,
+                                                                                       const M2& mask2)
+    {
+        auto& value1 = d1.value();
+        auto& mask1 = d1.has_value();
+        // Shapes of xfunctions are cached on first access, which must
+        // not happen concurrently.
+        value2.shape();
+        mask2.shape();
+        xf::xthread_pool::instance().parallel_for_range(d1.shape()[0],
+            [&value1, &mask1, &value2, &mask2](std::size_t first, std::size_t last)
+            {
+                auto r = xt::range(first, last);
+                auto value_view = xt::view(value1, r);
+                auto mask_view = xt::view(mask1, r);
+                xt::noalias(value_view) = xt::view(value2, r);
+                xt::noalias(mask_view) = xt::view(mask2, r);
+            });
+    }
+#endif
+
     template <class E1, class E2>
     inline void xexpression_assigner<xvariable_expression_tag>::assign_resized_xexpression(xexpression<E1>& e1,
                                                                                            const xexpression<E2>& e2,
@@ -107,6 +107,7 @@ namespace xf
         const_reference select(selector_sequence_type<N>&& selector) const;
 
         const std::tuple<xvariable_closure_t<CT>...>& arguments() const { return m_e; }
+        const functor_type& functor() const noexcept { return m_f; }
 
     private:
 
@@ -0,0 +1,723 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XFRAME_XVARIABLE_GROUPBY_HPP
+#define XFRAME_XVARIABLE_GROUPBY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "xframe_config.hpp"
+#include "xthread_pool.hpp"
+#include "xvariable_reducer.hpp"
+
+namespace xf
+{
+    /*********************
+     * xvariable_groupby *
+     *********************/
+
+    /**
+     * @class xvariable_groupby
+     * @brief Variable grouped along one of its dimensions.
+     *
+     * The xvariable_groupby class splits the positions of a dimension of a
+     * variable into groups of equal keys, and aggregates the values of each
+     * group. The aggregations return a variable with the same dimensions as
+     * the grouped variable, where the axis of the grouped dimension is
+     * replaced with the sorted list of distinct keys. Missing values are
+     * skipped, positions whose key is missing belong to no group.
+     *
+     * Groups are computed once, at construction: sorted keys are split in
+     * runs of equal keys, other keys are hashed. When parallel assignment is
+     * enabled, the aggregations of large variables accumulate partial
+     * results in each thread and merge them at the end.
+     *
+     * The xvariable_groupby holds a reference on the grouped variable, which
+     * must outlive it.
+     *
+     * @tparam V the type of the grouped variable.
+     * @tparam K the type of the keys.
+     * @sa groupby
+     */
+    template <class V, class K>
+    class xvariable_groupby
+    {
+    public:
+
+        using self_type = xvariable_groupby<V, K>;
+        using variable_type = V;
+        using key_type = K;
+        using key_list = std::vector<key_type>;
+        using value_type = detail::xreducer_value_type_t<variable_type>;
+        using coordinate_type = typename variable_type::coordinate_type;
+        using coordinate_map = typename variable_type::coordinate_map;
+        using dimension_list = typename variable_type::dimension_list;
+        using size_type = std::size_t;
+
+        template <class KV>
+        xvariable_groupby(const variable_type& v, const KV& keys);
+
+        size_type size() const noexcept;
+        const key_list& keys() const noexcept;
+
+        auto sum() const;
+        auto count() const;
+        auto mean() const;
+        auto amin() const;
+        auto amax() const;
+        auto first() const;
+        auto last() const;
+        auto nunique() const;
+
+        template <class F, class R>
+        auto reduce(F&& f, R init) const;
+
+    private:
+
+        template <class T>
+        using result_type = detail::xreducer_result_t<T, coordinate_type>;
+
+        template <class KV>
+        void init_groups(const KV& keys);
+
+        template <class KD, class KM>
+        bool keys_sorted(const KD& values, const KM& mask) const;
+
+        size_type output_size() const noexcept;
+
+        template <class T>
+        result_type<T> make_result() const;
+
+        bool use_parallel() const noexcept;
+
+        template <class F>
+        void for_each_row(size_type first, size_type last, F&& f) const;
+
+        template <class A, class F, class M>
+        std::vector<A> aggregate(A init, F&& f, M&& merge) const;
+
+        template <class F>
+        void with_mask(F&& f) const;
+
+        std::vector<size_type> count_buffer() const;
+
+        template <class T, class Cmp>
+        auto extremum(T init, Cmp cmp) const;
+
+        template <class F>
+        auto select_value(F&& merge, bool keep_first) const;
+
+        const variable_type& m_variable;
+        size_type m_dimension;
+        key_list m_keys;
+        std::vector<std::ptrdiff_t> m_groups;
+        size_type m_outer_size;
+        size_type m_length;
+        size_type m_inner_size;
+    };
+
+    template <class CCT, class ECT, class KCCT, class KECT>
+    auto groupby(const xvariable_container<CCT, ECT>& v, const xvariable_container<KCCT, KECT>& keys);
+
+    /************************************
+     * xvariable_groupby implementation *
+     ************************************/
+
+    namespace detail
+    {
+        template <class It>
+        inline It partition_nan(It first, It last, std::true_type)
+        {
+            return std::partition(first, last, [](const auto& x) { return !std::isnan(x); });
+        }
+
+        template <class It>
+        inline It partition_nan(It, It last, std::false_type)
+        {
+            return last;
+        }
+
+        // Number of distinct values of a buffer, which is reordered. NaN
+        // values are not ordered: they are moved out of the sorted range
+        // and all count as a single value.
+        template <class T>
+        inline std::size_t count_distinct(std::vector<T>& values)
+        {
+            auto last = partition_nan(values.begin(), values.end(), std::is_floating_point<T>());
+            std::sort(values.begin(), last);
+            std::size_t res = static_cast<std::size_t>(std::unique(values.begin(), last) - values.begin());
+            return last != values.end() ? res + 1 : res;
+        }
+    }
+
+    /**
+     * Builds the groups of the specified variable.
+     * @param v the variable to group.
+     * @param keys a one-dimensional variable holding the key of each position
+     * of the grouped dimension. Its dimension gives the grouped dimension, its
+     * axis must be the axis of this dimension in \c v.
+     * @throw std::invalid_argument if \c keys is not one-dimensional or if its
+     * axis differs from the axis of the grouped dimension.
+     * @throw std::runtime_error if the data of \c v is not row-major.
+     */
+    template <class V, class K>
+    template <class KV>
+    inline xvariable_groupby<V, K>::xvariable_groupby(const variable_type& v, const KV& keys)
+        : m_variable(v), m_dimension(0), m_keys(), m_groups(),
+          m_outer_size(1), m_length(0), m_inner_size(1)
+    {
+        if (keys.dimension() != 1)
+        {
+            throw std::invalid_argument("groupby: keys must be one-dimensional");
+        }
+        if (v.data().value().layout() != xt::layout_type::row_major)
+        {
+            throw std::runtime_error("groupby requires row-major data");
+        }
+
+        auto name = keys.dimension_labels()[0];
+        m_dimension = v.dimension_mapping()[name];
+        if (!(keys.coordinates()[name] == v.coordinates()[name]))
+        {
+            throw std::invalid_argument("groupby: keys and variable must have the same grouped axis");
+        }
+
+        const auto& shape = v.shape();
+        m_outer_size = std::accumulate(shape.cbegin(), shape.cbegin() + m_dimension,
+                                       size_type(1), std::multiplies<size_type>());
+        m_length = shape[m_dimension];
+        m_inner_size = std::accumulate(shape.cbegin() + m_dimension + 1, shape.cend(),
+                                       size_type(1), std::multiplies<size_type>());
+        init_groups(keys);
+    }
+
+    /**
+     * Returns the number of groups.
+     */
+    template <class V, class K>
+    inline auto xvariable_groupby<V, K>::size() const noexcept -> size_type
+    {
+        return m_keys.size();
+    }
+
+    /**
+     * Returns the sorted list of distinct keys, i.e. the labels of the
+     * grouped dimension in the aggregated variables.
+     */
+    template <class V, class K>
+    inline auto xvariable_groupby<V, K>::keys() const noexcept -> const key_list&
+    {
+        return m_keys;
+    }
+
+    /**
+     * @name Aggregations
+     */
+    //@{
+    /**
+     * Returns the sum of the non-missing values of each group. The sum
+     * of only missing values is 0.
+     */
+    template <class V, class K>
+    inline auto xvariable_groupby<V, K>::sum() const
+    {
+        using sum_type = detail::xsum_type_t<value_type>;
+        auto res = make_result<sum_type>();
+        const value_type* values = m_variable.data().value().data();
+        with_mask([this, values, &res](auto mask)
+        {
+            auto acc = this->aggregate(sum_type(0), [values, mask](size_type in, sum_type* out, size_type size)
+            {
+                detail::sum_kernel(values + in, mask + in, size, out, size_type(1));
+            }, [](sum_type& lhs, const sum_type& rhs) { lhs += rhs; });
+            std::copy(acc.cbegin(), acc.cend(), res.data().value().data());
+        });
+        auto& mask = res.data().has_value().storage();
+        std::fill(mask.begin(), mask.end(), true);
+        return res;
+    }
+
+    /**
+     * Returns the number of non-missing values of each group.
+     */
+    template <class V, class K>
+    inline auto xvariable_groupby<V, K>::count() const
+    {
+        auto res = make_result<size_type>();
+        auto cnt = count_buffer();
+        std::copy(cnt.cbegin(), cnt.cend(), res.data().value().data());
+        auto& mask = res.data().has_value().storage();
+        std::fill(mask.begin(), mask.end(), true);
+        return res;
+    }
+
+    /**
+     * Returns the mean of the non-missing values of each group. The mean
+     * is missing where all the values of the group are missing.
+     */
+    template <class V, class K>
+    inline auto xvariable_groupby<V, K>::mean() const
+    {
+        using mean_type = detail::xmean_type_t<value_type>;
+        auto res = make_result<mean_type>();
+        const value_type* values = m_variable.data().value().data();
+        std::vector<mean_type> sums;
+        with_mask([this, values, &sums](auto mask)
+        {
+            sums = this->aggregate(mean_type(0), [values, mask](size_type in, mean_type* out, size_type size)
+            {
+                detail::sum_kernel(values + in, mask + in, size, out, size_type(1));
+            }, [](mean_type& lhs, const mean_type& rhs) { lhs += rhs; });
+        });
+        auto cnt = count_buffer();
+        mean_type* res_values = res.data().value().data();
+        auto& mask = res.data().has_value().storage();
+        for (size_type i = 0; i < cnt.size(); ++i)
+        {
+            mask[i] = cnt[i] != 0;
+            res_values[i] = cnt[i] != 0 ? sums[i] / static_cast<mean_type>(cnt[i]) : mean_type(0);
+        }
+        return res;
+    }
+
+    /**
+     * Returns the minimum of the non-missing values of each group. The
+     * minimum is missing where all the values of the group are missing.
+     */
+    template <class V, class K>
+    inline auto xvariable_groupby<V, K>::amin() const
+    {
+        return extremum(std::numeric_limits<value_type>::max(),
+                        [](const value_type& a, const value_type& b) { return a < b; });
+    }
+
+    /**
+     * Returns the maximum of the non-missing values of each group. The
+     * maximum is missing where all the values of the group are missing.
+     */
+    template <class V, class K>
+    inline auto xvariable_groupby<V, K>::amax() const
+    {
+        return extremum(std::numeric_limits<value_type>::lowest(),
+                        [](const value_type& a, const value_type& b) { return b < a; });
+    }
+
+    /**
+     * Returns the first non-missing value of each group, in the order of
+     * the grouped dimension. The result is missing where all the values of
+     * the group are missing.
+     */
+    template <class V, class K>
+    inline auto xvariable_groupby<V, K>::first() const
+    {
+        return select_value([](auto& lhs, const auto& rhs)
+        {
+            if (lhs.second == 0)
+            {
+                lhs = rhs;
+            }
+        }, true);
+    }
+
+    /**
+     * Returns the last non-missing value of each group, in the order of
+     * the grouped dimension. The result is missing where all the values of
+     * the group are missing.
+     */
+    template <class V, class K>
+    inline auto xvariable_groupby<V, K>::last() const
+    {
+        return select_value([](auto& lhs, const auto& rhs)
+        {
+            if (rhs.second != 0)
+            {
+                lhs = rhs;
+            }
+        }, false);
+    }
+
+    /**
+     * Returns the number of distinct non-missing values of each group.
+     * NaN values count as a single value.
+     */
+    template <class V, class K>
+    inline auto xvariable_groupby<V, K>::nunique() const
+    {
+        auto res = make_result<size_type>();
+        size_type* res_values = res.data().value().data();
+        const value_type* values = m_variable.data().value().data();
+        size_type nb_groups = m_keys.size();
+
+        // Positions of each group along the grouped dimension, so that the
+        // values of an output element are gathered and counted at once.
+        std::vector<size_type> offsets(nb_groups + 1, size_type(0));
+        for (auto g : m_groups)
+        {
+            if (g >= 0)
+            {
+                ++offsets[static_cast<size_type>(g) + 1];
+            }
+        }
+        std::partial_sum(offsets.cbegin(), offsets.cend(), offsets.begin());
+        std::vector<size_type> positions(offsets.back());
+        std::vector<size_type> next(offsets.cbegin(), offsets.cend() - 1);
+        for (size_type i = 0; i < m_length; ++i)
+        {
+            if (m_groups[i] >= 0)
+            {
+                positions[next[static_cast<size_type>(m_groups[i])]++] = i;
+            }
+        }
+
+        std::vector<value_type> buffer;
+        with_mask([this, values, res_values, nb_groups, &offsets, &positions, &buffer](auto mask)
+        {
+            for (size_type o = 0; o < m_outer_size; ++o)
+            {
+                for (size_type g = 0; g < nb_groups; ++g)
+                {
+                    size_type out = (o * nb_groups + g) * m_inner_size;
+                    for (size_type j = 0; j < m_inner_size; ++j)
+                    {
+                        buffer.clear();
+                        for (size_type p = offsets[g]; p < offsets[g + 1]; ++p)
+                        {
+                            size_type in = (o * m_length + positions[p]) * m_inner_size + j;
+                            if (mask[in])
+                            {
+                                buffer.push_back(values[in]);
+                            }
+                        }
+                        res_values[out + j] = detail::count_distinct(buffer);
+                    }
+                }
+            }
+        });
+        auto& mask = res.data().has_value().storage();
+        std::fill(mask.begin(), mask.end(), true);
+        return res;
+    }
+
+    /**
+     * Aggregates each group with the specified function. The non-missing
+     * values of a group are folded in the order of the grouped dimension:
+     * the result is f(...f(f(init, v0), v1)..., vn). The result is missing
+     * where all the values of the group are missing. Custom aggregations
+     * are always evaluated sequentially.
+     * @param f the binary function folding the values.
+     * @param init the initial value of the fold, giving the value type of
+     * the result.
+     */
+    template <class V, class K>
+    template <class F, class R>
+    inline auto xvariable_groupby<V, K>::reduce(F&& f, R init) const
+    {
+        auto res = make_result<R>();
+        R* res_values = res.data().value().data();
+        std::fill(res_values, res_values + output_size(), init);
+        std::vector<size_type> cnt(output_size(), size_type(0));
+        const value_type* values = m_variable.data().value().data();
+        with_mask([this, values, res_values, &cnt, &f](auto mask)
+        {
+            this->for_each_row(0, m_outer_size * m_length, [values, mask, res_values, &cnt, &f](size_type in, size_type out, size_type size)
+            {
+                for (size_type k = 0; k < size; ++k)
+                {
+                    if (mask[in + k])
+                    {
+                        res_values[out + k] = f(res_values[out + k], values[in + k]);
+                        ++cnt[out + k];
+                    }
+                }
+            });
+        });
+        auto& mask = res.data().has_value().storage();
+        for (size_type i = 0; i < cnt.size(); ++i)
+        {
+            mask[i] = cnt[i] != 0;
+        }
+        return res;
+    }
+    //@}
+
+    // Sorted keys are split in runs of equal keys. Other keys are given
+    // an id in their order of appearance, then renumbered in the order of
+    // the sorted distinct keys.
+    template <class V, class K>
+    template <class KV>
+    inline void xvariable_groupby<V, K>::init_groups(const KV& keys)
+    {
+        const auto& key_values = keys.data().value();
+        const auto& key_mask = keys.data().has_value();
+        m_groups.assign(m_length, std::ptrdiff_t(-1));
+
+        if (keys_sorted(key_values, key_mask))
+        {
+            for (size_type i = 0; i < m_length; ++i)
+            {
+                if (key_mask(i))
+                {
+                    if (m_keys.empty() || !(m_keys.back() == key_values(i)))
+                    {
+                        m_keys.push_back(key_values(i));
+                    }
+                    m_groups[i] = static_cast<std::ptrdiff_t>(m_keys.size() - 1);
+                }
+            }
+            return;
+        }
+
+        std::unordered_map<key_type, std::ptrdiff_t> ids;
+        for (size_type i = 0; i < m_length; ++i)
+        {
+            if (key_mask(i))
+            {
+                auto inserted = ids.emplace(key_values(i), static_cast<std::ptrdiff_t>(m_keys.size()));
+                if (inserted.second)
+                {
+                    m_keys.push_back(key_values(i));
+                }
+                m_groups[i] = inserted.first->second;
+            }
+        }
+
+        std::vector<size_type> order(m_keys.size());
+        std::iota(order.begin(), order.end(), size_type(0));
+        std::sort(order.begin(), order.end(), [this](size_type lhs, size_type rhs) { return m_keys[lhs] < m_keys[rhs]; });
+        std::vector<std::ptrdiff_t> rank(m_keys.size());
+        key_list sorted_keys(m_keys.size());
+        for (size_type i = 0; i < order.size(); ++i)
+        {
+            rank[order[i]] = static_cast<std::ptrdiff_t>(i);
+            sorted_keys[i] = m_keys[order[i]];
+        }
+        for (auto& g : m_groups)
+        {
+            g = g < 0 ? g : rank[static_cast<size_type>(g)];
+        }
+        m_keys = std::move(sorted_keys);
+    }
+
+    template <class V, class K>
+    template <class KD, class KM>
+    inline bool xvariable_groupby<V, K>::keys_sorted(const KD& values, const KM& mask) const
+    {
+        const key_type* previous = nullptr;
+        for (size_type i = 0; i < m_length; ++i)
+        {
+            if (mask(i))
+            {
+                if (previous != nullptr && values(i) < *previous)
+                {
+                    return false;
+                }
+                previous = &values(i);
+            }
+        }
+        return true;
+    }
+
+    template <class V, class K>
+    inline auto xvariable_groupby<V, K>::output_size() const noexcept -> size_type
+    {
+        return m_outer_size * m_keys.size() * m_inner_size;
+    }
+
+    template <class V, class K>
+    template <class T>
+    inline auto xvariable_groupby<V, K>::make_result() const -> result_type<T>
+    {
+        using mapped_type = typename coordinate_type::axis_type::mapped_type;
+        using map_tag = typename coordinate_type::axis_type::map_container_tag;
+        const auto& labels = m_variable.dimension_labels();
+        coordinate_map coords = m_variable.coordinates().data();
+        coords[labels[m_dimension]] = xaxis<key_type, mapped_type, map_tag>(m_keys, true);
+        dimension_list dims(labels.cbegin(), labels.cend());
+        return result_type<T>(std::move(coords), std::move(dims));
+    }
+
+    template <class V, class K>
+    inline bool xvariable_groupby<V, K>::use_parallel() const noexcept
+    {
+#if XFRAME_ENABLE_PARALLEL_ASSIGN
+        return m_variable.data().size() >= std::size_t(XFRAME_PARALLEL_ASSIGN_THRESHOLD) &&
+            assign_thread_count() > 1;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Calls f(input_offset, output_offset, size) for each row in [first, last)
+     * whose key is not missing. A row is made of the elements following a
+     * position of the grouped dimension; its elements are contiguous in the
+     * input and in the output.
+     */
+    template <class V, class K>
+    template <class F>
+    inline void xvariable_groupby<V, K>::for_each_row(size_type first, size_type last, F&& f) const
+    {
+        size_type nb_groups = m_keys.size();
+        for (size_type r = first; r < last; ++r)
+        {
+            std::ptrdiff_t g = m_groups[r % m_length];
+            if (g >= 0)
+            {
+                size_type out = (r / m_length) * nb_groups + static_cast<size_type>(g);
+                f(r * m_inner_size, out * m_inner_size, m_inner_size);
+            }
+        }
+    }
+
+    /**
+     * Returns a buffer of the size of the output, initialized with init,
+     * where f(input_offset, output_pointer, size) has accumulated all the
+     * rows. In parallel, each task accumulates its rows in a partial buffer,
+     * the partial buffers are merged in the order of the rows with merge.
+     */
+    template <class V, class K>
+    template <class A, class F, class M>
+    inline std::vector<A> xvariable_groupby<V, K>::aggregate(A init, F&& f, M&& merge) const
+    {
+        size_type nb_rows = m_outer_size * m_length;
+        std::vector<A> res(output_size(), init);
+        if (use_parallel())
+        {
+            auto& pool = xthread_pool::instance();
+            size_type nb_tasks = std::min(nb_rows, pool.size());
+            std::vector<std::vector<A>> partials(nb_tasks, res);
+            pool.parallel_for(nb_tasks, [this, nb_rows, nb_tasks, &partials, &f](size_type t)
+            {
+                A* buffer = partials[t].data();
+                this->for_each_row(t * nb_rows / nb_tasks, (t + 1) * nb_rows / nb_tasks,
+                             [buffer, &f](size_type in, size_type out, size_type size) { f(in, buffer + out, size); });
+            });
+            for (const auto& partial : partials)
+            {
+                for (size_type i = 0; i < res.size(); ++i)
+                {
+                    merge(res[i], partial[i]);
+                }
+            }
+        }
+        else
+        {
+            A* buffer = res.data();
+            for_each_row(0, nb_rows, [buffer, &f](size_type in, size_type out, size_type size) { f(in, buffer + out, size); });
+        }
+        return res;
+    }
+
+    template <class V, class K>
+    template <class F>
+    inline void xvariable_groupby<V, K>::with_mask(F&& f) const
+    {
+        detail::with_mask_cursor(m_variable.data().has_value(), std::forward<F>(f));
+    }
+
+    template <class V, class K>
+    inline auto xvariable_groupby<V, K>::count_buffer() const -> std::vector<size_type>
+    {
+        std::vector<size_type> res;
+        with_mask([this, &res](auto mask)
+        {
+            res = this->aggregate(size_type(0), [mask](size_type in, size_type* out, size_type size)
+            {
+                detail::count_kernel(mask + in, size, out, size_type(1));
+            }, [](size_type& lhs, const size_type& rhs) { lhs += rhs; });
+        });
+        return res;
+    }
+
+    template <class V, class K>
+    template <class T, class Cmp>
+    inline auto xvariable_groupby<V, K>::extremum(T init, Cmp cmp) const
+    {
+        auto res = make_result<T>();
+        const value_type* values = m_variable.data().value().data();
+        with_mask([this, values, init, cmp, &res](auto mask)
+        {
+            auto ext = this->aggregate(init, [values, mask, cmp](size_type in, T* out, size_type size)
+            {
+                detail::extremum_kernel(values + in, mask + in, size, out, size_type(1), cmp);
+            }, [cmp](T& lhs, const T& rhs) { lhs = cmp(rhs, lhs) ? rhs : lhs; });
+            std::copy(ext.cbegin(), ext.cend(), res.data().value().data());
+        });
+        auto cnt = count_buffer();
+        auto& mask = res.data().has_value().storage();
+        for (size_type i = 0; i < cnt.size(); ++i)
+        {
+            mask[i] = cnt[i] != 0;
+        }
+        return res;
+    }
+
+    // Accumulates (value, count) pairs; keep_first selects whether the
+    // first or the last non-missing value of a row is kept.
+    template <class V, class K>
+    template <class F>
+    inline auto xvariable_groupby<V, K>::select_value(F&& merge, bool keep_first) const
+    {
+        using entry_type = std::pair<value_type, size_type>;
+        auto res = make_result<value_type>();
+        const value_type* values = m_variable.data().value().data();
+        std::vector<entry_type> selected;
+        with_mask([this, values, keep_first, &merge, &selected](auto mask)
+        {
+            selected = this->aggregate(entry_type(value_type(), 0), [values, mask, keep_first](size_type in, entry_type* out, size_type size)
+            {
+                for (size_type k = 0; k < size; ++k)
+                {
+                    if (mask[in + k] && !(keep_first && out[k].second != 0))
+                    {
+                        out[k].first = values[in + k];
+                    }
+                    out[k].second += static_cast<size_type>(mask[in + k]);
+                }
+            }, merge);
+        });
+        value_type* res_values = res.data().value().data();
+        auto& mask = res.data().has_value().storage();
+        for (size_type i = 0; i < selected.size(); ++i)
+        {
+            res_values[i] = selected[i].first;
+            mask[i] = selected[i].second != 0;
+        }
+        return res;
+    }
+
+    /**
+     * Groups the specified variable along a dimension.
+     * @param v the variable to group.
+     * @param keys a one-dimensional variable holding the key of each position
+     * of the grouped dimension. The type of the keys must be one of the label
+     * types of the coordinates of \c v.
+     * @return an xvariable_groupby object holding a reference on \c v.
+     */
+    template <class CCT, class ECT, class KCCT, class KECT>
+    inline auto groupby(const xvariable_container<CCT, ECT>& v, const xvariable_container<KCCT, KECT>& keys)
+    {
+        using variable_type = xvariable_container<CCT, ECT>;
+        using key_type = detail::xreducer_value_type_t<xvariable_container<KCCT, KECT>>;
+        return xvariable_groupby<variable_type, key_type>(v, keys);
+    }
+}
+
+#endif
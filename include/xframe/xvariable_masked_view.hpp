@@ -179,9 +179,14 @@ namespace xf
 
         void assign_temporary_impl(temporary_type&& tmp);
 
+        template <class F>
+        void for_each_selected(F&& f) const;
+
         data_type& data_impl() noexcept;
         const data_type& data_impl() const noexcept;
 
+        const detail::xaxis_mask_tables& mask_tables() const noexcept;
+
         CTV m_expr;
         CTAX m_axis_expr;
         data_type m_data;
@@ -232,7 +237,18 @@ namespace xf
     template <class E>
     inline xt::disable_xexpression<E, xvariable_masked_view<CTV, CTAX>>& xvariable_masked_view<CTV, CTAX>::operator=(const E& e)
     {
-        this->data().fill(e);
+        if (mask_tables().separable())
+        {
+            auto& data = m_expr.data();
+            for_each_selected([&data, &e](const auto& index)
+            {
+                data.element(index.cbegin(), index.cend()) = e;
+            });
+        }
+        else
+        {
+            this->data().fill(e);
+        }
         return *this;
     }
 
@@ -243,18 +259,74 @@ namespace xf
         const temporary_type& tmp2 = tmp;
         const auto& dim_label = dimension_labels();
         const auto& coords = coordinates();
-        std::vector<size_type> index(dim_label.size(), size_type(0));
-        selector_sequence_type<> selector(index.size());
-        bool end = false;
-        do
+        selector_sequence_type<> selector(dim_label.size());
+        using label_type = typename selector_sequence_type<>::value_type::second_type;
+        auto assign = [&](const auto& index)
         {
             for (size_type i = 0; i < index.size(); ++i)
             {
-                selector[i] = std::make_pair(dim_label[i], coords[dim_label[i]].label(index[i]));
+                selector[i] = std::make_pair(dim_label[i], detail::label_variant_cast<label_type>(coords[dim_label[i]].label(index[i])));
             }
             this->select(selector) = tmp2.select(selector);
-            end = xt::detail::increment_index(tmp2.data().shape(), index);
-        } while (!end);
+        };
+
+        if (mask_tables().separable())
+        {
+            for_each_selected(assign);
+        }
+        else
+        {
+            std::vector<size_type> index(dim_label.size(), size_type(0));
+            bool end = false;
+            do
+            {
+                assign(index);
+                end = xt::detail::increment_index(tmp2.data().shape(), index);
+            } while (!end);
+        }
+    }
+
+    // Calls f with each index selected by a separable mask, skipping the
+    // labels where the mask does not hold along an axis.
+    template <class CTV, class CTAX>
+    template <class F>
+    inline void xvariable_masked_view<CTV, CTAX>::for_each_selected(F&& f) const
+    {
+        const auto& shape = m_expr.shape();
+        std::size_t dimension = shape.size();
+        std::vector<std::vector<std::size_t>> selected(dimension);
+        std::vector<size_type> index(dimension);
+        for (std::size_t d = 0; d < dimension; ++d)
+        {
+            selected[d] = mask_tables().selected(d, static_cast<std::size_t>(shape[d]));
+            if (selected[d].empty())
+            {
+                return;
+            }
+            index[d] = static_cast<size_type>(selected[d][0]);
+        }
+
+        std::vector<std::size_t> pos(dimension, std::size_t(0));
+        while (true)
+        {
+            f(index);
+            std::size_t d = dimension;
+            while (d != 0)
+            {
+                --d;
+                if (++pos[d] != selected[d].size())
+                {
+                    index[d] = static_cast<size_type>(selected[d][pos[d]]);
+                    break;
+                }
+                if (d == 0)
+                {
+                    return;
+                }
+                pos[d] = 0;
+                index[d] = static_cast<size_type>(selected[d][0]);
+            }
+        }
     }
 
     template <class CTV, class CTAX>
@@ -269,6 +341,13 @@ namespace xf
         return m_data;
     }
 
+    // The tables of a separable mask are built once by the mask generator.
+    template <class CTV, class CTAX>
+    inline auto xvariable_masked_view<CTV, CTAX>::mask_tables() const noexcept -> const detail::xaxis_mask_tables&
+    {
+        return m_data.visible().functor().tables();
+    }
+
     /**
      * Apply a mask on a variable where the axis expression is false. e.g.
      * ```
@@ -0,0 +1,607 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XFRAME_XVARIABLE_REDUCER_HPP
+#define XFRAME_XVARIABLE_REDUCER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "xbitset_mask.hpp"
+#include "xvariable.hpp"
+
+namespace xf
+{
+    /*********************
+     * reducer functions *
+     *********************/
+
+    template <class CCT, class ECT>
+    using xreducer_dimension_list = typename xvariable_container<CCT, ECT>::dimension_list;
+
+    namespace detail
+    {
+        template <class V>
+        using xreducer_value_type_t = typename std::decay_t<decltype(std::declval<const V&>().data().value())>::value_type;
+
+        template <class T>
+        using xsum_type_t = decltype(std::declval<T>() + std::declval<T>());
+
+        template <class T>
+        using xmean_type_t = std::conditional_t<std::is_floating_point<T>::value, T, double>;
+
+        template <class T, class CCT>
+        using xreducer_result_t = xvariable<T, std::decay_t<CCT>>;
+    }
+
+    template <class CCT, class ECT>
+    auto sum(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims);
+
+    template <class CCT, class ECT>
+    auto count(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims);
+
+    template <class CCT, class ECT>
+    auto mean(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims);
+
+    template <class CCT, class ECT>
+    auto amin(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims);
+
+    template <class CCT, class ECT>
+    auto amax(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims);
+
+    template <class CCT, class ECT>
+    auto variance(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims,
+                  std::size_t ddof = 0);
+
+    template <class CCT, class ECT>
+    auto stddev(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims,
+                std::size_t ddof = 0);
+
+    /************************************
+     * reducer functions implementation *
+     ************************************/
+
+    namespace detail
+    {
+        /**
+         * Positions of the output of a reduction, computed from the variable
+         * to reduce and the names of the reduced dimensions. The output keeps
+         * the other dimensions in their original order.
+         */
+        template <class V>
+        class xreducer_layout
+        {
+        public:
+
+            using variable_type = V;
+            using coordinate_type = typename variable_type::coordinate_type;
+            using coordinate_map = typename variable_type::coordinate_map;
+            using dimension_list = typename variable_type::dimension_list;
+            using shape_type = std::vector<std::size_t>;
+            using strides_type = std::vector<std::size_t>;
+
+            xreducer_layout(const variable_type& v, const dimension_list& dims);
+
+            const shape_type& input_shape() const noexcept;
+            const strides_type& output_strides() const noexcept;
+            std::size_t output_size() const noexcept;
+
+            coordinate_map output_coordinates() const;
+            dimension_list output_dimensions() const;
+
+            template <class F>
+            void for_each_row(F&& f) const;
+
+        private:
+
+            const variable_type& m_variable;
+            std::vector<bool> m_reduced;
+            shape_type m_input_shape;
+            strides_type m_output_strides;
+            std::size_t m_output_size;
+        };
+
+        template <class V>
+        inline xreducer_layout<V>::xreducer_layout(const variable_type& v, const dimension_list& dims)
+            : m_variable(v), m_reduced(v.dimension(), false),
+              m_input_shape(v.shape().cbegin(), v.shape().cend()),
+              m_output_strides(v.dimension(), 0), m_output_size(1)
+        {
+            if (v.data().value().layout() != xt::layout_type::row_major)
+            {
+                throw std::runtime_error("reducers require row-major data");
+            }
+
+            for (const auto& name : dims)
+            {
+                m_reduced[v.dimension_mapping()[name]] = true;
+            }
+
+            for (std::size_t i = m_input_shape.size(); i != 0; --i)
+            {
+                if (!m_reduced[i - 1])
+                {
+                    m_output_strides[i - 1] = m_output_size;
+                    m_output_size *= m_input_shape[i - 1];
+                }
+            }
+        }
+
+        template <class V>
+        inline auto xreducer_layout<V>::input_shape() const noexcept -> const shape_type&
+        {
+            return m_input_shape;
+        }
+
+        template <class V>
+        inline auto xreducer_layout<V>::output_strides() const noexcept -> const strides_type&
+        {
+            return m_output_strides;
+        }
+
+        template <class V>
+        inline std::size_t xreducer_layout<V>::output_size() const noexcept
+        {
+            return m_output_size;
+        }
+
+        template <class V>
+        inline auto xreducer_layout<V>::output_coordinates() const -> coordinate_map
+        {
+            coordinate_map res;
+            const auto& labels = m_variable.dimension_labels();
+            for (std::size_t i = 0; i < labels.size(); ++i)
+            {
+                if (!m_reduced[i])
+                {
+                    res.insert(std::make_pair(labels[i], m_variable.coordinates()[labels[i]]));
+                }
+            }
+            return res;
+        }
+
+        template <class V>
+        inline auto xreducer_layout<V>::output_dimensions() const -> dimension_list
+        {
+            dimension_list res;
+            const auto& labels = m_variable.dimension_labels();
+            for (std::size_t i = 0; i < labels.size(); ++i)
+            {
+                if (!m_reduced[i])
+                {
+                    res.push_back(labels[i]);
+                }
+            }
+            return res;
+        }
+
+        /**
+         * Traverses the input in row-major order, one row of the innermost
+         * dimension at a time. For each row, calls f(input_offset, output_offset,
+         * row_size, output_step), where output_step is 0 if the innermost
+         * dimension is reduced, and 1 otherwise. This allows the kernels to
+         * run contiguous loops over the data.
+         */
+        template <class V>
+        template <class F>
+        inline void xreducer_layout<V>::for_each_row(F&& f) const
+        {
+            std::size_t dim = m_input_shape.size();
+            if (dim == 0)
+            {
+                f(std::size_t(0), std::size_t(0), std::size_t(1), std::size_t(0));
+                return;
+            }
+
+            std::size_t row_size = m_input_shape[dim - 1];
+            std::size_t step = m_output_strides[dim - 1];
+            std::size_t nb_rows = std::accumulate(m_input_shape.cbegin(), m_input_shape.cend() - 1,
+                                                  std::size_t(1), std::multiplies<std::size_t>());
+            if (row_size == 0 || nb_rows == 0)
+            {
+                return;
+            }
+
+            std::vector<std::size_t> index(dim - 1, 0);
+            std::size_t in_offset = 0;
+            std::size_t out_offset = 0;
+            for (std::size_t r = 0; r < nb_rows; ++r)
+            {
+                f(in_offset, out_offset, row_size, step);
+                in_offset += row_size;
+                for (std::size_t d = dim - 1; d != 0; --d)
+                {
+                    out_offset += m_output_strides[d - 1];
+                    if (++index[d - 1] != m_input_shape[d - 1])
+                    {
+                        break;
+                    }
+                    out_offset -= index[d - 1] * m_output_strides[d - 1];
+                    index[d - 1] = 0;
+                }
+            }
+        }
+
+        /***********
+         * kernels *
+         ***********/
+
+        // Each kernel handles one row of the innermost dimension. When this
+        // dimension is reduced, it accumulates in a local scalar; otherwise
+        // it updates a contiguous row of the output. Missing values are
+        // skipped with a select instead of a branch, so that both loops
+        // can be vectorized.
+
+        template <class T, class M, class A>
+        inline void sum_kernel(const T* v, M m, std::size_t size,
+                               A* sum, std::size_t step) noexcept
+        {
+            if (step == 0)
+            {
+                A acc = A(0);
+                for (std::size_t k = 0; k < size; ++k)
+                {
+                    acc += m[k] ? static_cast<A>(v[k]) : A(0);
+                }
+                *sum += acc;
+            }
+            else
+            {
+                for (std::size_t k = 0; k < size; ++k)
+                {
+                    sum[k] += m[k] ? static_cast<A>(v[k]) : A(0);
+                }
+            }
+        }
+
+        template <class M>
+        inline void count_kernel(M m, std::size_t size, std::size_t* count, std::size_t step) noexcept
+        {
+            if (step == 0)
+            {
+                std::size_t acc = 0;
+                for (std::size_t k = 0; k < size; ++k)
+                {
+                    acc += static_cast<std::size_t>(m[k]);
+                }
+                *count += acc;
+            }
+            else
+            {
+                for (std::size_t k = 0; k < size; ++k)
+                {
+                    count[k] += static_cast<std::size_t>(m[k]);
+                }
+            }
+        }
+
+        template <class T, class M, class Cmp>
+        inline void extremum_kernel(const T* v, M m, std::size_t size,
+                                    T* res, std::size_t step, Cmp cmp) noexcept
+        {
+            if (step == 0)
+            {
+                T acc = *res;
+                for (std::size_t k = 0; k < size; ++k)
+                {
+                    acc = (m[k] && cmp(v[k], acc)) ? v[k] : acc;
+                }
+                *res = acc;
+            }
+            else
+            {
+                for (std::size_t k = 0; k < size; ++k)
+                {
+                    res[k] = (m[k] && cmp(v[k], res[k])) ? v[k] : res[k];
+                }
+            }
+        }
+
+        template <class T, class M, class A>
+        inline void square_deviation_kernel(const T* v, M m, std::size_t size,
+                                            const A* mean, A* res, std::size_t step) noexcept
+        {
+            if (step == 0)
+            {
+                A acc = A(0);
+                A mu = *mean;
+                for (std::size_t k = 0; k < size; ++k)
+                {
+                    A d = static_cast<A>(v[k]) - mu;
+                    acc += m[k] ? d * d : A(0);
+                }
+                *res += acc;
+            }
+            else
+            {
+                for (std::size_t k = 0; k < size; ++k)
+                {
+                    A d = static_cast<A>(v[k]) - mean[k];
+                    res[k] += m[k] ? d * d : A(0);
+                }
+            }
+        }
+
+        /*******************
+         * reducer helpers *
+         *******************/
+
+        template <class R, class V>
+        inline R make_reducer_result(const xreducer_layout<V>& layout)
+        {
+            return R(layout.output_coordinates(), layout.output_dimensions());
+        }
+
+        template <class V, class A>
+        inline void accumulate_sum(const V& v, const xreducer_layout<V>& layout, A* sum)
+        {
+            const auto* values = v.data().value().data();
+            with_mask_cursor(v.data().has_value(), [values, sum, &layout](auto mask)
+            {
+                layout.for_each_row([values, mask, sum](std::size_t in, std::size_t out, std::size_t size, std::size_t step)
+                {
+                    sum_kernel(values + in, mask + in, size, sum + out, step);
+                });
+            });
+        }
+
+        template <class V>
+        inline void accumulate_count(const V& v, const xreducer_layout<V>& layout, std::size_t* count)
+        {
+            with_mask_cursor(v.data().has_value(), [count, &layout](auto mask)
+            {
+                layout.for_each_row([mask, count](std::size_t in, std::size_t out, std::size_t size, std::size_t step)
+                {
+                    count_kernel(mask + in, size, count + out, step);
+                });
+            });
+        }
+
+        template <class V, class T, class Cmp>
+        inline void accumulate_extremum(const V& v, const xreducer_layout<V>& layout, T* res, Cmp cmp)
+        {
+            const auto* values = v.data().value().data();
+            with_mask_cursor(v.data().has_value(), [values, res, cmp, &layout](auto mask)
+            {
+                layout.for_each_row([values, mask, res, cmp](std::size_t in, std::size_t out, std::size_t size, std::size_t step)
+                {
+                    extremum_kernel(values + in, mask + in, size, res + out, step, cmp);
+                });
+            });
+        }
+
+        template <class V, class A>
+        inline void accumulate_square_deviation(const V& v, const xreducer_layout<V>& layout, const A* mean, A* res)
+        {
+            const auto* values = v.data().value().data();
+            with_mask_cursor(v.data().has_value(), [values, mean, res, &layout](auto mask)
+            {
+                layout.for_each_row([values, mask, mean, res](std::size_t in, std::size_t out, std::size_t size, std::size_t step)
+                {
+                    square_deviation_kernel(values + in, mask + in, size, mean + out, res + out, step);
+                });
+            });
+        }
+
+        // Returns the mean in the first buffer, the number of non-missing
+        // values in the second one.
+        template <class A, class V>
+        inline std::pair<std::vector<A>, std::vector<std::size_t>> compute_mean(const V& v, const xreducer_layout<V>& layout)
+        {
+            std::vector<A> sum(layout.output_size(), A(0));
+            std::vector<std::size_t> cnt(layout.output_size(), std::size_t(0));
+            accumulate_sum(v, layout, sum.data());
+            accumulate_count(v, layout, cnt.data());
+            for (std::size_t i = 0; i < sum.size(); ++i)
+            {
+                sum[i] = cnt[i] != 0 ? sum[i] / static_cast<A>(cnt[i]) : A(0);
+            }
+            return std::make_pair(std::move(sum), std::move(cnt));
+        }
+
+        template <class T, class V, class Cmp>
+        inline auto extremum(const V& v, const typename V::dimension_list& dims, T init, Cmp cmp)
+        {
+            using result_type = xreducer_result_t<T, typename V::coordinate_type>;
+            xreducer_layout<V> layout(v, dims);
+            result_type res = make_reducer_result<result_type>(layout);
+            T* values = res.data().value().data();
+            std::fill(values, values + layout.output_size(), init);
+            std::vector<std::size_t> cnt(layout.output_size(), std::size_t(0));
+            accumulate_extremum(v, layout, values, cmp);
+            accumulate_count(v, layout, cnt.data());
+            auto& mask = res.data().has_value().storage();
+            for (std::size_t i = 0; i < cnt.size(); ++i)
+            {
+                mask[i] = cnt[i] != 0;
+            }
+            return res;
+        }
+
+        template <class V>
+        inline auto variance_impl(const V& v, const typename V::dimension_list& dims, std::size_t ddof, bool take_sqrt)
+        {
+            using value_type = xreducer_value_type_t<V>;
+            using mean_type = xmean_type_t<value_type>;
+            using result_type = xreducer_result_t<mean_type, typename V::coordinate_type>;
+            xreducer_layout<V> layout(v, dims);
+            auto mean_count = compute_mean<mean_type>(v, layout);
+            result_type res = make_reducer_result<result_type>(layout);
+            mean_type* values = res.data().value().data();
+            std::fill(values, values + layout.output_size(), mean_type(0));
+            accumulate_square_deviation(v, layout, mean_count.first.data(), values);
+            auto& mask = res.data().has_value().storage();
+            for (std::size_t i = 0; i < layout.output_size(); ++i)
+            {
+                std::size_t n = mean_count.second[i];
+                mask[i] = n > ddof;
+                values[i] = n > ddof ? values[i] / static_cast<mean_type>(n - ddof) : mean_type(0);
+                if (take_sqrt)
+                {
+                    values[i] = std::sqrt(values[i]);
+                }
+            }
+            return res;
+        }
+    }
+
+    /**
+     * @defgroup reducers Reducers
+     *
+     * Reducers aggregate the values of a variable along the dimensions
+     * given by name. The reduced dimensions are dropped from the result,
+     * the other ones keep their order and coordinates. Missing values
+     * are skipped.
+     */
+
+    /**
+     * @ingroup reducers
+     * Returns the sum of the non-missing values of \c v along the specified
+     * dimensions. The sum of only missing values is 0.
+     * @param v the variable to reduce.
+     * @param dims the names of the dimensions to reduce.
+     */
+    template <class CCT, class ECT>
+    inline auto sum(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims)
+    {
+        using variable_type = xvariable_container<CCT, ECT>;
+        using value_type = detail::xreducer_value_type_t<variable_type>;
+        using sum_type = detail::xsum_type_t<value_type>;
+        using result_type = detail::xreducer_result_t<sum_type, CCT>;
+        detail::xreducer_layout<variable_type> layout(v, dims);
+        result_type res = detail::make_reducer_result<result_type>(layout);
+        sum_type* values = res.data().value().data();
+        std::fill(values, values + layout.output_size(), sum_type(0));
+        auto& mask = res.data().has_value().storage();
+        std::fill(mask.begin(), mask.end(), true);
+        detail::accumulate_sum(v, layout, values);
+        return res;
+    }
+
+    /**
+     * @ingroup reducers
+     * Returns the number of non-missing values of \c v along the specified
+     * dimensions.
+     * @param v the variable to reduce.
+     * @param dims the names of the dimensions to reduce.
+     */
+    template <class CCT, class ECT>
+    inline auto count(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims)
+    {
+        using variable_type = xvariable_container<CCT, ECT>;
+        using result_type = detail::xreducer_result_t<std::size_t, CCT>;
+        detail::xreducer_layout<variable_type> layout(v, dims);
+        result_type res = detail::make_reducer_result<result_type>(layout);
+        std::size_t* values = res.data().value().data();
+        std::fill(values, values + layout.output_size(), std::size_t(0));
+        auto& mask = res.data().has_value().storage();
+        std::fill(mask.begin(), mask.end(), true);
+        detail::accumulate_count(v, layout, values);
+        return res;
+    }
+
+    /**
+     * @ingroup reducers
+     * Returns the mean of the non-missing values of \c v along the specified
+     * dimensions. The mean is missing where all the values are missing.
+     * @param v the variable to reduce.
+     * @param dims the names of the dimensions to reduce.
+     */
+    template <class CCT, class ECT>
+    inline auto mean(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims)
+    {
+        using variable_type = xvariable_container<CCT, ECT>;
+        using value_type = detail::xreducer_value_type_t<variable_type>;
+        using mean_type = detail::xmean_type_t<value_type>;
+        using result_type = detail::xreducer_result_t<mean_type, CCT>;
+        detail::xreducer_layout<variable_type> layout(v, dims);
+        auto mean_count = detail::compute_mean<mean_type>(v, layout);
+        result_type res = detail::make_reducer_result<result_type>(layout);
+        std::copy(mean_count.first.cbegin(), mean_count.first.cend(), res.data().value().data());
+        auto& mask = res.data().has_value().storage();
+        for (std::size_t i = 0; i < layout.output_size(); ++i)
+        {
+            mask[i] = mean_count.second[i] != 0;
+        }
+        return res;
+    }
+
+    /**
+     * @ingroup reducers
+     * Returns the minimum of the non-missing values of \c v along the specified
+     * dimensions. The minimum is missing where all the values are missing.
+     * @param v the variable to reduce.
+     * @param dims the names of the dimensions to reduce.
+     */
+    template <class CCT, class ECT>
+    inline auto amin(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims)
+    {
+        using value_type = detail::xreducer_value_type_t<xvariable_container<CCT, ECT>>;
+        return detail::extremum<value_type>(v, dims, std::numeric_limits<value_type>::max(),
+                                            [](const value_type& a, const value_type& b) { return a < b; });
+    }
+
+    /**
+     * @ingroup reducers
+     * Returns the maximum of the non-missing values of \c v along the specified
+     * dimensions. The maximum is missing where all the values are missing.
+     * @param v the variable to reduce.
+     * @param dims the names of the dimensions to reduce.
+     */
+    template <class CCT, class ECT>
+    inline auto amax(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims)
+    {
+        using value_type = detail::xreducer_value_type_t<xvariable_container<CCT, ECT>>;
+        return detail::extremum<value_type>(v, dims, std::numeric_limits<value_type>::lowest(),
+                                            [](const value_type& a, const value_type& b) { return b < a; });
+    }
+
+    /**
+     * @ingroup reducers
+     * Returns the variance of the non-missing values of \c v along the specified
+     * dimensions. The variance is missing where the number of non-missing values
+     * is not greater than \c ddof.
+     * @param v the variable to reduce.
+     * @param dims the names of the dimensions to reduce.
+     * @param ddof the delta degrees of freedom; the divisor is N - ddof.
+     */
+    template <class CCT, class ECT>
+    inline auto variance(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims,
+                         std::size_t ddof)
+    {
+        return detail::variance_impl(v, dims, ddof, false);
+    }
+
+    /**
+     * @ingroup reducers
+     * Returns the standard deviation of the non-missing values of \c v along the
+     * specified dimensions. The standard deviation is missing where the number
+     * of non-missing values is not greater than \c ddof.
+     * @param v the variable to reduce.
+     * @param dims the names of the dimensions to reduce.
+     * @param ddof the delta degrees of freedom; the divisor is N - ddof.
+     */
+    template <class CCT, class ECT>
+    inline auto stddev(const xvariable_container<CCT, ECT>& v, const xreducer_dimension_list<CCT, ECT>& dims,
+                       std::size_t ddof)
+    {
+        return detail::variance_impl(v, dims, ddof, true);
+    }
+}
+
+#endif
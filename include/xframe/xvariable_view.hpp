@@ -11,7 +11,10 @@
 #ifndef XFRAME_XVARIABLE_VIEW_HPP
 #define XFRAME_XVARIABLE_VIEW_HPP
 
+#include <limits>
+
 #include "xtensor/xdynamic_view.hpp"
+#include "xtensor/xstrided_view.hpp"
 
 #include "xvariable.hpp"
 #include "xcoordinate_system.hpp"
@@ -60,6 +63,85 @@ namespace xt
 
 namespace xf
 {
+    namespace detail
+    {
+        // Converts a dynamic slice into a strided slice; keep and drop
+        // slices cannot be expressed with strides.
+        struct strided_slice_converter
+        {
+            using slice_type = xt::xstrided_slice<std::ptrdiff_t>;
+
+            template <class S>
+            bool operator()(const S& slice, slice_type& res) const
+            {
+                res = slice;
+                return true;
+            }
+
+            template <class T>
+            bool operator()(const xt::xkeep_slice<T>&, slice_type&) const
+            {
+                return false;
+            }
+
+            template <class T>
+            bool operator()(const xt::xdrop_slice<T>&, slice_type&) const
+            {
+                return false;
+            }
+        };
+
+        // Computes the first position and the step of a slice whose
+        // positions are an arithmetic progression; keep and drop slices
+        // (and squeezed dimensions) are tabulated instead.
+        struct affine_slice_converter
+        {
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+
+            explicit affine_slice_converter(size_type size)
+                : m_size(size)
+            {
+            }
+
+            template <class S>
+            bool operator()(const S&, size_type&, difference_type&) const
+            {
+                return false;
+            }
+
+            template <class T>
+            bool operator()(const xt::xrange<T>& r, size_type& start, difference_type& step) const
+            {
+                start = static_cast<size_type>(r(0));
+                step = difference_type(1);
+                return true;
+            }
+
+            template <class T>
+            bool operator()(const xt::xstepped_range<T>& r, size_type& start, difference_type& step) const
+            {
+                start = static_cast<size_type>(r(0));
+                step = static_cast<difference_type>(r.step_size(0));
+                return true;
+            }
+
+            template <class A, class B, class C>
+            bool operator()(const xt::xrange_adaptor<A, B, C>& r, size_type& start, difference_type& step) const
+            {
+                return (*this)(r.get(m_size), start, step);
+            }
+
+            bool operator()(xt::xall_tag, size_type& start, difference_type& step) const
+            {
+                start = size_type(0);
+                step = difference_type(1);
+                return true;
+            }
+
+            size_type m_size;
+        };
+    }
 
     template <class CT>
     class xvariable_view : public xt::xview_semantic<xvariable_view<CT>>,
@@ -75,6 +157,7 @@ namespace xf
         using underlying_data_type = typename xexpression_type::data_type;
         using data_type = xt::xdynamic_view<xt::apply_cv_t<CT, underlying_data_type>&, typename underlying_data_type::shape_type>;
         using slice_vector = xt::xdynamic_slice_vector;
+        using strided_slice_vector = xt::xstrided_slice_vector;
 
         static constexpr bool is_const = std::is_const<std::remove_reference_t<CT>>::value;
         using value_type = typename xexpression_type::value_type;
@@ -204,7 +287,14 @@ namespace xf
 
     private:
 
-        using internal_index_type = std::vector<size_type>;
+        using internal_index_type = xt::svector<size_type, 8>;
+
+        void init_squeeze(const squeeze_map& squeeze, const slice_vector& slices);
+        void init_strided_slices(const slice_vector& slices);
+        bool has_same_coordinates(const temporary_type& tmp) const;
+
+        template <class It>
+        internal_index_type build_element_index(It first, It last) const;
 
         template <std::size_t... I, class... Args>
         reference access_impl(std::index_sequence<I...>, Args... args);
@@ -221,9 +311,6 @@ namespace xf
         template <std::size_t I>
         void fill_accessor(internal_index_type& accessor) const;
 
-        template <class It>
-        internal_index_type build_element_accessor(It first, It last) const;
-
         template <std::size_t... I, class... Args>
         reference locate_impl(std::index_sequence<I...>, Args&&... args);
 
@@ -257,15 +344,42 @@ namespace xf
         template <class Idx>
         void fill_squeeze(Idx& index) const;
 
+        size_type position(size_type dim, size_type idx) const;
+
+        template <class Idx>
+        reference access_element(const Idx& index);
+
+        template <class Idx>
+        const_reference access_element(const Idx& index) const;
+
         template <std::size_t N>
         void adapt_iselector(iselector_sequence_type<N>& selector) const;
 
         void assign_temporary_impl(temporary_type&& tmp);
 
         CT m_e;
-        squeeze_map m_squeeze;
         data_type m_data;
 
+        // Squeeze tables: the index in the underlying expression is
+        // m_fixed_index, where the dimension of the view s is replaced at
+        // m_slots[s] with m_starts[s] + i * m_steps[s] for ranges and all,
+        // and with m_positions[m_position_offsets[s] + i] for keep and drop
+        // slices.
+        static constexpr size_type affine_position = std::numeric_limits<size_type>::max();
+
+        internal_index_type m_fixed_index;
+        std::vector<size_type> m_squeezed;
+        std::vector<size_type> m_slots;
+        std::vector<size_type> m_starts;
+        std::vector<difference_type> m_steps;
+        std::vector<size_type> m_position_offsets;
+        std::vector<size_type> m_positions;
+
+        // Non empty when every slice is an integer, a range or all, in
+        // which case assignments go through a strided view of the
+        // underlying data instead of the dynamic view.
+        strided_slice_vector m_strided_slices;
+
         friend class xt::xview_semantic<xvariable_view<CT>>;
     };
 
@@ -298,9 +412,10 @@ namespace xf
                                               slice_vector&& slices)
         : coordinate_base(std::move(coord), std::move(dim)),
           m_e(std::forward<E>(e)),
-          m_squeeze(std::move(squeeze)),
           m_data(xt::dynamic_view(m_e.data(), slices))
     {
+        init_squeeze(squeeze, slices);
+        init_strided_slices(slices);
     }
 
     template <class CT>
@@ -328,7 +443,15 @@ namespace xf
     template <class E>
     xt::disable_xexpression<E, xvariable_view<CT>>& xvariable_view<CT>::operator=(const E& e)
     {
-        data().fill(e);
+        if (!m_strided_slices.empty())
+        {
+            auto sv = xt::strided_view(m_e.data(), m_strided_slices);
+            sv.fill(e);
+        }
+        else
+        {
+            data().fill(e);
+        }
         return *this;
     }
 
@@ -354,14 +477,14 @@ namespace xf
     template <class... Args>
     inline auto xvariable_view<CT>::operator()(Args... args) ->reference
     {
-        if (m_squeeze.empty())
+        if (m_squeezed.empty())
         {
             return access_impl(std::make_index_sequence<sizeof...(Args)>(), args...);
         }
         else
         {
             auto idx = build_accessor(std::forward<Args>(args)...);
-            return m_e.element(idx);
+            return access_element(idx);
         }
     }
 
@@ -369,14 +492,14 @@ namespace xf
     template <class... Args>
     inline auto xvariable_view<CT>::operator()(Args... args) const -> const_reference
     {
-        if (m_squeeze.empty())
+        if (m_squeezed.empty())
         {
             return access_impl(std::make_index_sequence<sizeof...(Args)>(), args...);
         }
         else
         {
             auto idx = build_accessor(std::forward<Args>(args)...);
-            return m_e.element(idx);
+            return access_element(idx);
         }
     }
 
@@ -384,46 +507,42 @@ namespace xf
     template <std::size_t N>
     inline auto xvariable_view<CT>::element(const index_type<N>& index) -> reference
     {
-        auto idx = build_element_accessor(index.cbegin(), index.cend());
-        return m_e.element(idx.cbegin(), idx.cend());
+        return access_element(build_element_index(index.cbegin(), index.cend()));
     }
 
     template <class CT>
     template <std::size_t N>
     inline auto xvariable_view<CT>::element(const index_type<N>& index) const -> const_reference
     {
-        auto idx = build_element_accessor(index.cbegin(), index.cend());
-        return m_e.element(idx.cbegin(), idx.cend());
+        return access_element(build_element_index(index.cbegin(), index.cend()));
     }
 
     template <class CT>
     template <std::size_t N>
     inline auto xvariable_view<CT>::element(index_type<N>&& index) -> reference
     {
-        auto idx = build_element_accessor(index.cbegin(), index.cend());
-        return m_e.element(idx);
+        return access_element(build_element_index(index.cbegin(), index.cend()));
     }
 
     template <class CT>
     template <std::size_t N>
     inline auto xvariable_view<CT>::element(index_type<N>&& index) const -> const_reference
     {
-        auto idx = build_element_accessor(index.cbegin(), index.cend());
-        return m_e.element(idx);
+        return access_element(build_element_index(index.cbegin(), index.cend()));
     }
 
     template <class CT>
     template <class... Args>
     inline auto xvariable_view<CT>::locate(Args&&... args) -> reference
     {
-        if (m_squeeze.empty())
+        if (m_squeezed.empty())
         {
             return locate_impl(std::make_index_sequence<sizeof...(Args)>(), std::forward<Args>(args)...);
         }
         else
         {
             auto idx = build_locator(std::forward<Args>(args)...);
-            return m_e.element(idx);
+            return access_element(idx);
         }
     }
 
@@ -431,14 +550,14 @@ namespace xf
     template <class... Args>
     inline auto xvariable_view<CT>::locate(Args&&... args) const -> const_reference
     {
-        if (m_squeeze.empty())
+        if (m_squeezed.empty())
         {
             return locate_impl(std::make_index_sequence<sizeof...(Args)>(), std::forward<Args>(args)...);
         }
         else
         {
             auto idx = build_locator(std::forward<Args>(args)...);
-            return m_e.element(idx);
+            return access_element(idx);
         }
     }
 
@@ -448,7 +567,7 @@ namespace xf
     {
         locator_sequence_type<N> tmp(locator);
         auto idx = build_element_locator<N>(std::move(tmp));
-        return m_e.element(idx);
+        return access_element(idx);
     }
 
     template <class CT>
@@ -456,8 +575,8 @@ namespace xf
     inline auto xvariable_view<CT>::locate_element(const locator_sequence_type<N>& locator) const -> const_reference
     {
         locator_sequence_type<N> tmp(locator);
-        auto idx = build_element_locator<N>(std::move(locator));
-        return m_e.element(idx);
+        auto idx = build_element_locator<N>(std::move(tmp));
+        return access_element(idx);
     }
 
     template <class CT>
@@ -465,7 +584,7 @@ namespace xf
     inline auto xvariable_view<CT>::locate_element(locator_sequence_type<N>&& locator) -> reference
     {
         auto idx = build_element_locator<N>(std::move(locator));
-        return m_e.element(idx);
+        return access_element(idx);
     }
 
     template <class CT>
@@ -473,7 +592,7 @@ namespace xf
     inline auto xvariable_view<CT>::locate_element(locator_sequence_type<N>&& locator) const -> const_reference
     {
         auto idx = build_element_locator<N>(std::move(locator));
-        return m_e.element(idx);
+        return access_element(idx);
     }
 
     template <class CT>
@@ -540,23 +659,22 @@ namespace xf
     template <std::size_t... I, class... Args>
     inline auto xvariable_view<CT>::access_impl(std::index_sequence<I...>, Args... args) -> reference
     {
-        return m_e(coordinates()[dimension_labels()[I]].index(args)...);
+        return m_e(position(I, static_cast<size_type>(args))...);
     }
 
     template <class CT>
     template <std::size_t... I, class... Args>
     inline auto xvariable_view<CT>::access_impl(std::index_sequence<I...>, Args... args) const -> const_reference
     {
-        return m_e(coordinates()[dimension_labels()[I]].index(args)...);
+        return m_e(position(I, static_cast<size_type>(args))...);
     }
 
     template <class CT>
     template <class... Args>
     inline auto xvariable_view<CT>::build_accessor(Args&&... args) const -> internal_index_type
     {
-        internal_index_type accessor(m_e.dimension());
+        internal_index_type accessor(m_fixed_index);
         fill_accessor<0>(accessor, std::forward<Args>(args)...);
-        fill_squeeze(accessor);
         return accessor;
     }
 
@@ -564,8 +682,7 @@ namespace xf
     template <std::size_t I, class T, class... Args>
     inline void xvariable_view<CT>::fill_accessor(internal_index_type& accessor, T idx, Args... args) const
     {
-        std::size_t new_index = m_e.dimension_mapping()[dimension_labels()[I]];
-        accessor[new_index] = coordinates()[dimension_labels()[I]].index(idx);
+        accessor[m_slots[I]] = position(I, static_cast<size_type>(idx));
         fill_accessor<I + 1>(accessor, std::forward<Args>(args)...);
     }
 
@@ -577,27 +694,12 @@ namespace xf
 
     template <class CT>
     template <class It>
-    inline auto xvariable_view<CT>::build_element_accessor(It first, It last) const -> internal_index_type
+    inline auto xvariable_view<CT>::build_element_index(It first, It last) const -> internal_index_type
     {
-        internal_index_type res(m_e.dimension());
-        size_type current_index = 0;
-        size_type i = 0;
-        while (first != last)
+        internal_index_type res(m_fixed_index);
+        for (size_type i = 0; first != last; ++first, ++i)
         {
-            auto iter = m_squeeze.find(current_index);
-            if (iter != m_squeeze.end())
-            {
-                res[current_index++] = iter->second;
-            }
-            else
-            {
-                res[current_index++] = coordinates()[dimension_labels()[i++]].index(*first++);
-            }
-        }
-        while (current_index != res.size())
-        {
-            res[current_index] = m_squeeze.find(current_index)->second;
-            ++current_index;
+            res[m_slots[i]] = position(i, static_cast<size_type>(*first));
         }
         return res;
     }
@@ -613,16 +715,15 @@ namespace xf
     template <std::size_t... I, class... Args>
     inline auto xvariable_view<CT>::locate_impl(std::index_sequence<I...>, Args&&... args) const -> const_reference
     {
-        m_e(coordinates()[dimension_mapping().labels()[I]][args]...);
+        return m_e(coordinates()[dimension_mapping().labels()[I]][args]...);
     }
 
     template <class CT>
     template <class... Args>
     inline auto xvariable_view<CT>::build_locator(Args&&... args) const -> internal_index_type
     {
-        internal_index_type locator(m_e.dimension());
+        internal_index_type locator(m_fixed_index);
         fill_locator<0>(locator, std::forward<Args>(args)...);
-        fill_squeeze(locator);
         return locator;
     }
 
@@ -630,8 +731,7 @@ namespace xf
     template <std::size_t I, class T, class... Args>
     inline void xvariable_view<CT>::fill_locator(internal_index_type& locator, T idx, Args&&... args) const
     {
-        std::size_t new_index = m_e.dimension_mapping()[dimension_labels()[I]];
-        locator[new_index] = coordinates()[dimension_labels()[I]][idx];
+        locator[m_slots[I]] = coordinates()[dimension_labels()[I]][idx];
         fill_locator<I + 1>(locator, std::forward<Args>(args)...);
     }
 
@@ -645,39 +745,15 @@ namespace xf
     template <std::size_t N>
     inline auto xvariable_view<CT>::build_element_locator(locator_sequence_type<N>&& locator) const -> internal_index_type
     {
-        if (m_squeeze.empty())
-        {
-            locator_type<N> loc(std::move(locator));
-            return loc.get_index(coordinates(), dimension_mapping());
-        }
-        else
+        internal_index_type res(m_fixed_index);
+        const auto& coord = m_e.coordinates();
+        const auto& dims = m_e.dimension_mapping();
+        for (size_type i = 0; i != locator.size(); ++i)
         {
-            internal_index_type res(m_e.dimension());
-            size_type current_index = size_type(0);
-            size_type i = size_type(0);
-            const auto& coord = m_e.coordinates();
-            const auto& dims = m_e.dimension_mapping();
-            while (i != locator.size())
-            {
-                auto iter = m_squeeze.find(current_index);
-                if (iter != m_squeeze.cend())
-                {
-                    res[current_index] = iter->second;
-                }
-                else
-                {
-                    res[current_index] = coord[dims.labels()[current_index]][locator[i]];
-                    ++i;
-                }
-                ++current_index;
-            }
-            while (current_index != res.size())
-            {
-                res[current_index] = m_squeeze.find(current_index)->second;
-                ++current_index;
-            }
-            return res;
+            size_type slot = m_slots[i];
+            res[slot] = coord[dims.labels()[slot]][locator[i]];
         }
+        return res;
     }
 
     template <class CT>
@@ -686,7 +762,7 @@ namespace xf
     {
         typename S::index_type idx = selector.get_index(coordinates(), m_e.dimension_mapping());
         fill_squeeze(idx);
-        return m_e.element(idx);
+        return access_element(idx);
     }
 
     template <class CT>
@@ -695,7 +771,7 @@ namespace xf
     {
         typename S::index_type idx = selector.get_index(coordinates(), m_e.dimension_mapping());
         fill_squeeze(idx);
-        return m_e.element(idx);
+        return access_element(idx);
     }
 
     template <class CT>
@@ -706,7 +782,7 @@ namespace xf
         if (idx.second)
         {
             fill_squeeze(idx.first);
-            return m_e.element(idx.first);
+            return access_element(idx.first);
         }
         else
         {
@@ -731,12 +807,131 @@ namespace xf
     template <class Idx>
     inline void xvariable_view<CT>::fill_squeeze(Idx& index) const
     {
-        for (const auto& sq : m_squeeze)
+        for (size_type d : m_squeezed)
         {
-            index[sq.first] = sq.second;
+            index[d] = m_fixed_index[d];
         }
     }
 
+    template <class CT>
+    inline auto xvariable_view<CT>::position(size_type dim, size_type idx) const -> size_type
+    {
+        size_type offset = m_position_offsets[dim];
+        return offset == affine_position ?
+            m_starts[dim] + static_cast<size_type>(m_steps[dim] * static_cast<difference_type>(idx)) :
+            m_positions[offset + idx];
+    }
+
+    template <class CT>
+    template <class Idx>
+    inline auto xvariable_view<CT>::access_element(const Idx& index) -> reference
+    {
+        return m_e.data().element(index.cbegin(), index.cend());
+    }
+
+    template <class CT>
+    template <class Idx>
+    inline auto xvariable_view<CT>::access_element(const Idx& index) const -> const_reference
+    {
+        return m_e.data().element(index.cbegin(), index.cend());
+    }
+
+    template <class CT>
+    inline void xvariable_view<CT>::init_squeeze(const squeeze_map& squeeze, const slice_vector& slices)
+    {
+        m_fixed_index = internal_index_type(m_e.dimension(), size_type(0));
+        m_squeezed.reserve(squeeze.size());
+        for (const auto& sq : squeeze)
+        {
+            m_fixed_index[sq.first] = static_cast<size_type>(sq.second);
+            m_squeezed.push_back(static_cast<size_type>(sq.first));
+        }
+
+        const auto& dim_labels = dimension_labels();
+        const auto& coords = coordinates();
+        const auto& shape = m_e.data().shape();
+        m_slots.resize(dim_labels.size());
+        m_starts.resize(dim_labels.size(), size_type(0));
+        m_steps.resize(dim_labels.size(), difference_type(0));
+        m_position_offsets.resize(dim_labels.size());
+        for (size_type i = 0; i < dim_labels.size(); ++i)
+        {
+            size_type slot = static_cast<size_type>(m_e.dimension_mapping()[dim_labels[i]]);
+            m_slots[i] = slot;
+            bool affine = false;
+            if (slot < slices.size())
+            {
+                detail::affine_slice_converter converter(static_cast<std::size_t>(shape[slot]));
+                std::size_t start = 0;
+                std::ptrdiff_t step = 0;
+                affine = xtl::visit([&converter, &start, &step](const auto& slice) { return converter(slice, start, step); },
+                                    slices[slot]);
+                m_starts[i] = static_cast<size_type>(start);
+                m_steps[i] = static_cast<difference_type>(step);
+            }
+            if (affine)
+            {
+                m_position_offsets[i] = affine_position;
+            }
+            else
+            {
+                const auto& axis = coords[dim_labels[i]];
+                m_position_offsets[i] = m_positions.size();
+                for (size_type j = 0; j < axis.size(); ++j)
+                {
+                    m_positions.push_back(static_cast<size_type>(axis.index(j)));
+                }
+            }
+        }
+    }
+
+    template <class CT>
+    inline void xvariable_view<CT>::init_strided_slices(const slice_vector& slices)
+    {
+        detail::strided_slice_converter converter;
+        strided_slice_vector strided_slices(slices.size());
+        for (size_type i = 0; i < slices.size(); ++i)
+        {
+            auto& res = strided_slices[i];
+            bool strided = xtl::visit([&converter, &res](const auto& slice) { return converter(slice, res); }, slices[i]);
+            if (!strided)
+            {
+                return;
+            }
+        }
+        m_strided_slices = std::move(strided_slices);
+    }
+
+    template <class CT>
+    inline bool xvariable_view<CT>::has_same_coordinates(const temporary_type& tmp) const
+    {
+        const auto& dim_label = dimension_labels();
+        const auto& tmp_dim_label = tmp.dimension_labels();
+        if (dim_label.size() != tmp_dim_label.size() ||
+            !std::equal(dim_label.cbegin(), dim_label.cend(), tmp_dim_label.cbegin()))
+        {
+            return false;
+        }
+
+        for (const auto& label : dim_label)
+        {
+            const auto& axis = coordinates()[label];
+            const auto& tmp_axis = tmp.coordinates()[label];
+            if (axis.size() != tmp_axis.size())
+            {
+                return false;
+            }
+            for (size_type i = 0; i < axis.size(); ++i)
+            {
+                if (!(axis.label(i) == tmp_axis.label(i)))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
     template <class CT>
     template <std::size_t N>
     inline void xvariable_view<CT>::adapt_iselector(iselector_sequence_type<N>& selector) const
@@ -750,6 +945,13 @@ namespace xf
     template <class CT>
     inline void xvariable_view<CT>::assign_temporary_impl(temporary_type&& tmp)
     {
+        if (!m_strided_slices.empty() && has_same_coordinates(tmp))
+        {
+            auto sv = xt::strided_view(m_e.data(), m_strided_slices);
+            xt::noalias(sv) = tmp.data();
+            return;
+        }
+
         // TODO: improve this with iterators when they are available
         const temporary_type& tmp2 = tmp;
         const auto& dim_label = dimension_labels();
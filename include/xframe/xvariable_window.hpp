@@ -0,0 +1,789 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#ifndef XFRAME_XVARIABLE_WINDOW_HPP
+#define XFRAME_XVARIABLE_WINDOW_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "xvariable_reducer.hpp"
+
+namespace xf
+{
+    /********************
+     * xvariable_window *
+     ********************/
+
+    /**
+     * @class xvariable_window
+     * @brief Moving windows along a dimension of a variable.
+     *
+     * The xvariable_window class aggregates, for each position of a
+     * dimension, the values of a window ending at this position. The
+     * aggregations return a variable with the coordinates and the
+     * dimensions of the original variable. Missing values are skipped;
+     * the result is missing where the window holds fewer than
+     * \c min_periods non-missing values.
+     *
+     * Each aggregation is computed in a single pass over the variable:
+     * sums and moments are updated when a value enters or leaves the
+     * window, minimum and maximum are tracked with monotonic queues.
+     *
+     * The xvariable_window holds a reference on the variable, which must
+     * outlive it.
+     *
+     * @tparam V the type of the variable.
+     * @sa rolling, rolling_span, expanding
+     */
+    template <class V>
+    class xvariable_window
+    {
+    public:
+
+        using self_type = xvariable_window<V>;
+        using variable_type = V;
+        using value_type = detail::xreducer_value_type_t<variable_type>;
+        using coordinate_type = typename variable_type::coordinate_type;
+        using dimension_list = typename variable_type::dimension_list;
+        using key_type = typename variable_type::key_type;
+        using size_type = std::size_t;
+        using position_list = std::vector<size_type>;
+
+        xvariable_window(const variable_type& v, size_type dimension, position_list&& begins,
+                         size_type min_periods);
+
+        auto count() const;
+        auto sum() const;
+        auto mean() const;
+        auto variance(size_type ddof = 0) const;
+        auto stddev(size_type ddof = 0) const;
+        auto amin() const;
+        auto amax() const;
+
+    private:
+
+        template <class T>
+        using result_type = detail::xreducer_result_t<T, coordinate_type>;
+
+        template <class T>
+        result_type<T> make_result() const;
+
+        template <class R, class A, class D, class E>
+        void scan(R&& reset, A&& add, D&& remove, E&& emit) const;
+
+        template <class T>
+        auto moments(bool is_mean, size_type ddof, bool take_sqrt) const;
+
+        template <class Cmp>
+        auto extremum(Cmp cmp) const;
+
+        const variable_type& m_variable;
+        position_list m_begins;
+        size_type m_min_periods;
+        size_type m_outer_size;
+        size_type m_length;
+        size_type m_inner_size;
+    };
+
+    template <class CCT, class ECT>
+    auto rolling(const xvariable_container<CCT, ECT>& v,
+                 const typename xvariable_container<CCT, ECT>::key_type& dim,
+                 std::size_t window, std::size_t min_periods = 1);
+
+    template <class CCT, class ECT, class S>
+    auto rolling_span(const xvariable_container<CCT, ECT>& v,
+                      const typename xvariable_container<CCT, ECT>::key_type& dim,
+                      const S& span, std::size_t min_periods = 1);
+
+    template <class CCT, class ECT>
+    auto expanding(const xvariable_container<CCT, ECT>& v,
+                   const typename xvariable_container<CCT, ECT>::key_type& dim,
+                   std::size_t min_periods = 1);
+
+    /***********************************
+     * xvariable_window implementation *
+     ***********************************/
+
+    namespace detail
+    {
+        // Sum of a window, updated when a value enters or leaves it.
+        template <class T, bool = std::is_floating_point<T>::value>
+        class xwindow_sum
+        {
+        public:
+
+            void reset() noexcept { m_sum = T(0); }
+            void add(const T& x) noexcept { m_sum += x; }
+            void remove(const T& x) noexcept { m_sum -= x; }
+            T value() const noexcept { return m_sum; }
+
+        private:
+
+            T m_sum = T(0);
+        };
+
+        // Floating point sums use Neumaier's compensated summation, so that
+        // a large value leaving the window does not leave its rounding error
+        // behind. Non-finite values are counted rather than summed, so that
+        // an infinity leaving the window does not turn the sum into NaN.
+        template <class T>
+        class xwindow_sum<T, true>
+        {
+        public:
+
+            void reset() noexcept
+            {
+                m_sum = T(0);
+                m_compensation = T(0);
+                m_nb_pos_inf = 0;
+                m_nb_neg_inf = 0;
+                m_nb_nan = 0;
+            }
+
+            void add(const T& x) noexcept { update(x, 1); }
+            void remove(const T& x) noexcept { update(x, -1); }
+
+            T value() const noexcept
+            {
+                if (m_nb_nan != 0 || (m_nb_pos_inf != 0 && m_nb_neg_inf != 0))
+                {
+                    return std::numeric_limits<T>::quiet_NaN();
+                }
+                if (m_nb_pos_inf != 0)
+                {
+                    return std::numeric_limits<T>::infinity();
+                }
+                if (m_nb_neg_inf != 0)
+                {
+                    return -std::numeric_limits<T>::infinity();
+                }
+                return m_sum + m_compensation;
+            }
+
+        private:
+
+            void update(const T& x, int sign) noexcept
+            {
+                if (std::isnan(x))
+                {
+                    m_nb_nan += sign;
+                }
+                else if (std::isinf(x))
+                {
+                    (x > T(0) ? m_nb_pos_inf : m_nb_neg_inf) += sign;
+                }
+                else
+                {
+                    T y = sign > 0 ? x : -x;
+                    T t = m_sum + y;
+                    m_compensation += std::abs(m_sum) >= std::abs(y) ? (m_sum - t) + y : (y - t) + m_sum;
+                    m_sum = t;
+                }
+            }
+
+            T m_sum = T(0);
+            T m_compensation = T(0);
+            std::ptrdiff_t m_nb_pos_inf = 0;
+            std::ptrdiff_t m_nb_neg_inf = 0;
+            std::ptrdiff_t m_nb_nan = 0;
+        };
+
+        // Mean and sum of squared deviations of a window, updated with
+        // Welford's algorithm extended to the removal of values. As in
+        // xwindow_sum, non-finite values are counted rather than
+        // accumulated. remove returns false when the value leaving the
+        // window carried most of the squared deviations: the remaining
+        // state has then lost its precision and must be rebuilt from the
+        // values still in the window.
+        template <class T>
+        class xwindow_moments
+        {
+        public:
+
+            void reset() noexcept
+            {
+                m_mean = T(0);
+                m_m2 = T(0);
+                m_nb_finite = 0;
+                m_nb_pos_inf = 0;
+                m_nb_neg_inf = 0;
+                m_nb_nan = 0;
+            }
+
+            void add(const T& x) noexcept
+            {
+                if (update_non_finite(x, 1))
+                {
+                    return;
+                }
+                T d = x - m_mean;
+                m_mean += d / static_cast<T>(++m_nb_finite);
+                m_m2 += d * (x - m_mean);
+            }
+
+            bool remove(const T& x) noexcept
+            {
+                if (update_non_finite(x, -1))
+                {
+                    return true;
+                }
+                if (--m_nb_finite == 0)
+                {
+                    m_mean = T(0);
+                    m_m2 = T(0);
+                    return true;
+                }
+                T d = x - m_mean;
+                m_mean -= d / static_cast<T>(m_nb_finite);
+                T m2 = m_m2 - d * (x - m_mean);
+                bool precise = m2 >= m_m2 / T(2);
+                m_m2 = m2;
+                return precise;
+            }
+
+            std::size_t size() const noexcept
+            {
+                return static_cast<std::size_t>(m_nb_finite + m_nb_pos_inf + m_nb_neg_inf + m_nb_nan);
+            }
+
+            T mean() const noexcept
+            {
+                if (m_nb_nan != 0 || (m_nb_pos_inf != 0 && m_nb_neg_inf != 0))
+                {
+                    return std::numeric_limits<T>::quiet_NaN();
+                }
+                if (m_nb_pos_inf != 0)
+                {
+                    return std::numeric_limits<T>::infinity();
+                }
+                if (m_nb_neg_inf != 0)
+                {
+                    return -std::numeric_limits<T>::infinity();
+                }
+                return m_mean;
+            }
+
+            // Removals may leave a small negative rounding error.
+            T m2() const noexcept
+            {
+                if (m_nb_pos_inf != 0 || m_nb_neg_inf != 0 || m_nb_nan != 0)
+                {
+                    return std::numeric_limits<T>::quiet_NaN();
+                }
+                return std::max(m_m2, T(0));
+            }
+
+        private:
+
+            bool update_non_finite(const T& x, int sign) noexcept
+            {
+                if (std::isnan(x))
+                {
+                    m_nb_nan += sign;
+                    return true;
+                }
+                if (std::isinf(x))
+                {
+                    (x > T(0) ? m_nb_pos_inf : m_nb_neg_inf) += sign;
+                    return true;
+                }
+                return false;
+            }
+
+            T m_mean = T(0);
+            T m_m2 = T(0);
+            std::ptrdiff_t m_nb_finite = 0;
+            std::ptrdiff_t m_nb_pos_inf = 0;
+            std::ptrdiff_t m_nb_neg_inf = 0;
+            std::ptrdiff_t m_nb_nan = 0;
+        };
+    }
+
+    /**
+     * Builds the windows of the specified dimension.
+     * @param v the variable to aggregate.
+     * @param dimension the position of the dimension in \c v.
+     * @param begins the position of the first element of the window of
+     * each position of the dimension; this list must be non-decreasing.
+     * @param min_periods the minimal number of non-missing values of a
+     * window for its aggregate to be non-missing.
+     */
+    template <class V>
+    inline xvariable_window<V>::xvariable_window(const variable_type& v, size_type dimension,
+                                                 position_list&& begins, size_type min_periods)
+        : m_variable(v), m_begins(std::move(begins)), m_min_periods(min_periods),
+          m_outer_size(1), m_length(0), m_inner_size(1)
+    {
+        if (v.data().value().layout() != xt::layout_type::row_major)
+        {
+            throw std::runtime_error("window operations require row-major data");
+        }
+        const auto& shape = v.shape();
+        m_outer_size = std::accumulate(shape.cbegin(), shape.cbegin() + dimension,
+                                       size_type(1), std::multiplies<size_type>());
+        m_length = shape[dimension];
+        m_inner_size = std::accumulate(shape.cbegin() + dimension + 1, shape.cend(),
+                                       size_type(1), std::multiplies<size_type>());
+    }
+
+    /**
+     * @name Aggregations
+     */
+    //@{
+    /**
+     * Returns the number of non-missing values of each window.
+     */
+    template <class V>
+    inline auto xvariable_window<V>::count() const
+    {
+        auto res = make_result<size_type>();
+        size_type* values = res.data().value().data();
+        auto& mask = res.data().has_value().storage();
+        std::vector<size_type> cnt(m_inner_size);
+        scan([&cnt]() { std::fill(cnt.begin(), cnt.end(), size_type(0)); },
+             [&cnt](size_type j, const value_type&) { ++cnt[j]; },
+             [&cnt](size_type j, const value_type&) { --cnt[j]; },
+             [this, &cnt, values, &mask](size_type offset)
+             {
+                 for (size_type j = 0; j < cnt.size(); ++j)
+                 {
+                     values[offset + j] = cnt[j];
+                     mask[offset + j] = cnt[j] >= m_min_periods;
+                 }
+             });
+        return res;
+    }
+
+    /**
+     * Returns the sum of the non-missing values of each window.
+     */
+    template <class V>
+    inline auto xvariable_window<V>::sum() const
+    {
+        using sum_type = detail::xsum_type_t<value_type>;
+        auto res = make_result<sum_type>();
+        sum_type* values = res.data().value().data();
+        auto& mask = res.data().has_value().storage();
+        std::vector<detail::xwindow_sum<sum_type>> acc(m_inner_size);
+        std::vector<size_type> cnt(m_inner_size);
+        scan([&acc, &cnt]()
+             {
+                 for (auto& a : acc)
+                 {
+                     a.reset();
+                 }
+                 std::fill(cnt.begin(), cnt.end(), size_type(0));
+             },
+             [&acc, &cnt](size_type j, const value_type& x) { acc[j].add(static_cast<sum_type>(x)); ++cnt[j]; },
+             [&acc, &cnt](size_type j, const value_type& x)
+             {
+                 // Restarting from an empty window drops the accumulated
+                 // rounding error.
+                 if (--cnt[j] == 0)
+                 {
+                     acc[j].reset();
+                 }
+                 else
+                 {
+                     acc[j].remove(static_cast<sum_type>(x));
+                 }
+             },
+             [this, &acc, &cnt, values, &mask](size_type offset)
+             {
+                 for (size_type j = 0; j < acc.size(); ++j)
+                 {
+                     values[offset + j] = cnt[j] != 0 ? acc[j].value() : sum_type(0);
+                     mask[offset + j] = cnt[j] >= m_min_periods;
+                 }
+             });
+        return res;
+    }
+
+    /**
+     * Returns the mean of the non-missing values of each window.
+     */
+    template <class V>
+    inline auto xvariable_window<V>::mean() const
+    {
+        using mean_type = detail::xmean_type_t<value_type>;
+        return moments<mean_type>(true, 0, false);
+    }
+
+    /**
+     * Returns the variance of the non-missing values of each window. The
+     * variance is also missing where the number of non-missing values is
+     * not greater than \c ddof.
+     * @param ddof the delta degrees of freedom; the divisor is N - ddof.
+     */
+    template <class V>
+    inline auto xvariable_window<V>::variance(size_type ddof) const
+    {
+        using mean_type = detail::xmean_type_t<value_type>;
+        return moments<mean_type>(false, ddof, false);
+    }
+
+    /**
+     * Returns the standard deviation of the non-missing values of each
+     * window. The standard deviation is also missing where the number of
+     * non-missing values is not greater than \c ddof.
+     * @param ddof the delta degrees of freedom; the divisor is N - ddof.
+     */
+    template <class V>
+    inline auto xvariable_window<V>::stddev(size_type ddof) const
+    {
+        using mean_type = detail::xmean_type_t<value_type>;
+        return moments<mean_type>(false, ddof, true);
+    }
+
+    /**
+     * Returns the minimum of the non-missing values of each window.
+     */
+    template <class V>
+    inline auto xvariable_window<V>::amin() const
+    {
+        return extremum([](const value_type& a, const value_type& b) { return a < b; });
+    }
+
+    /**
+     * Returns the maximum of the non-missing values of each window.
+     */
+    template <class V>
+    inline auto xvariable_window<V>::amax() const
+    {
+        return extremum([](const value_type& a, const value_type& b) { return b < a; });
+    }
+    //@}
+
+    template <class V>
+    template <class T>
+    inline auto xvariable_window<V>::make_result() const -> result_type<T>
+    {
+        const auto& labels = m_variable.dimension_labels();
+        return result_type<T>(m_variable.coordinates().data(), dimension_list(labels.cbegin(), labels.cend()));
+    }
+
+    /**
+     * Slides the windows along the dimension. For each line of the other
+     * dimensions, calls reset(), then for each position of the dimension,
+     * remove(j, x) for each non-missing value x leaving the window and
+     * add(j, x) for each non-missing value x entering it, and finally
+     * emit(offset). j is the position of the value in its row, and offset
+     * the offset of the current row in the data. The rows of a position
+     * are contiguous, so that the states of all the lines are updated in
+     * a single loop.
+     */
+    template <class V>
+    template <class R, class A, class D, class E>
+    inline void xvariable_window<V>::scan(R&& reset, A&& add, D&& remove, E&& emit) const
+    {
+        const value_type* values = m_variable.data().value().data();
+        detail::with_mask_cursor(m_variable.data().has_value(), [&](auto mask)
+        {
+            for (size_type o = 0; o < m_outer_size; ++o)
+            {
+                reset();
+                size_type line = o * m_length;
+                size_type first = 0;
+                for (size_type i = 0; i < m_length; ++i)
+                {
+                    for (; first < m_begins[i]; ++first)
+                    {
+                        size_type offset = (line + first) * m_inner_size;
+                        for (size_type j = 0; j < m_inner_size; ++j)
+                        {
+                            if (mask[offset + j])
+                            {
+                                remove(j, values[offset + j]);
+                            }
+                        }
+                    }
+                    size_type offset = (line + i) * m_inner_size;
+                    for (size_type j = 0; j < m_inner_size; ++j)
+                    {
+                        if (mask[offset + j])
+                        {
+                            add(j, values[offset + j]);
+                        }
+                    }
+                    emit(offset);
+                }
+            }
+        });
+    }
+
+    // Each lane updates its moments when a value enters or leaves the
+    // window, and rebuilds them from the window when a removal has
+    // cancelled most of them.
+    template <class V>
+    template <class T>
+    inline auto xvariable_window<V>::moments(bool is_mean, size_type ddof, bool take_sqrt) const
+    {
+        auto res = make_result<T>();
+        T* res_values = res.data().value().data();
+        auto& res_mask = res.data().has_value().storage();
+        const value_type* values = m_variable.data().value().data();
+        detail::xwindow_moments<T> acc;
+        detail::with_mask_cursor(m_variable.data().has_value(), [&](auto mask)
+        {
+            for (size_type o = 0; o < m_outer_size; ++o)
+            {
+                size_type line = o * m_length * m_inner_size;
+                for (size_type j = 0; j < m_inner_size; ++j)
+                {
+                    const value_type* v = values + line + j;
+                    auto m = mask + (line + j);
+                    acc.reset();
+                    size_type first = 0;
+                    for (size_type i = 0; i < m_length; ++i)
+                    {
+                        bool precise = true;
+                        for (; first < m_begins[i]; ++first)
+                        {
+                            size_type pos = first * m_inner_size;
+                            if (m[pos])
+                            {
+                                precise = acc.remove(static_cast<T>(v[pos])) && precise;
+                            }
+                        }
+                        if (!precise)
+                        {
+                            acc.reset();
+                            for (size_type k = first; k < i; ++k)
+                            {
+                                size_type pos = k * m_inner_size;
+                                if (m[pos])
+                                {
+                                    acc.add(static_cast<T>(v[pos]));
+                                }
+                            }
+                        }
+                        size_type pos = i * m_inner_size;
+                        if (m[pos])
+                        {
+                            acc.add(static_cast<T>(v[pos]));
+                        }
+                        size_type out = line + pos + j;
+                        size_type n = acc.size();
+                        bool valid = n != 0 && n >= m_min_periods && (is_mean || n > ddof);
+                        res_mask[out] = valid;
+                        if (!valid)
+                        {
+                            res_values[out] = T(0);
+                        }
+                        else if (is_mean)
+                        {
+                            res_values[out] = acc.mean();
+                        }
+                        else
+                        {
+                            T var = acc.m2() / static_cast<T>(n - ddof);
+                            res_values[out] = take_sqrt ? std::sqrt(var) : var;
+                        }
+                    }
+                }
+            }
+        });
+        return res;
+    }
+
+    // Each lane keeps a queue of positions whose values are monotonic; the
+    // front of the queue is the extremum of the window. Each position is
+    // pushed and popped at most once.
+    template <class V>
+    template <class Cmp>
+    inline auto xvariable_window<V>::extremum(Cmp cmp) const
+    {
+        auto res = make_result<value_type>();
+        value_type* res_values = res.data().value().data();
+        auto& res_mask = res.data().has_value().storage();
+        const value_type* values = m_variable.data().value().data();
+        std::vector<size_type> queue(m_length);
+        detail::with_mask_cursor(m_variable.data().has_value(), [&](auto mask)
+        {
+            for (size_type o = 0; o < m_outer_size; ++o)
+            {
+                size_type line = o * m_length * m_inner_size;
+                for (size_type j = 0; j < m_inner_size; ++j)
+                {
+                    const value_type* v = values + line + j;
+                    auto m = mask + (line + j);
+                    size_type head = 0;
+                    size_type tail = 0;
+                    size_type cnt = 0;
+                    size_type first = 0;
+                    for (size_type i = 0; i < m_length; ++i)
+                    {
+                        for (; first < m_begins[i]; ++first)
+                        {
+                            cnt -= static_cast<size_type>(m[first * m_inner_size]);
+                        }
+                        while (head != tail && queue[head] < m_begins[i])
+                        {
+                            ++head;
+                        }
+                        size_type pos = i * m_inner_size;
+                        if (m[pos])
+                        {
+                            while (head != tail && !cmp(v[queue[tail - 1] * m_inner_size], v[pos]))
+                            {
+                                --tail;
+                            }
+                            queue[tail++] = i;
+                            ++cnt;
+                        }
+                        size_type out = line + pos + j;
+                        bool valid = cnt != 0 && cnt >= m_min_periods;
+                        res_mask[out] = valid;
+                        res_values[out] = valid ? v[queue[head] * m_inner_size] : value_type();
+                    }
+                }
+            }
+        });
+        return res;
+    }
+
+    namespace detail
+    {
+        // Computes the windows (label - span, label] of a sorted axis with
+        // two pointers.
+        template <class S>
+        class xwindow_span_builder
+        {
+        public:
+
+            using position_list = std::vector<std::size_t>;
+
+            explicit xwindow_span_builder(const S& span)
+                : m_span(span)
+            {
+            }
+
+            template <class A>
+            position_list operator()(const A& axis) const
+            {
+                using key_type = typename A::key_type;
+                return build(axis, std::integral_constant<bool, std::is_arithmetic<key_type>::value &&
+                                                                std::is_arithmetic<S>::value>());
+            }
+
+        private:
+
+            template <class A>
+            position_list build(const A& axis, std::true_type) const
+            {
+                if (!axis.is_sorted())
+                {
+                    throw std::invalid_argument("rolling_span: the axis must be sorted");
+                }
+                using common_type = std::common_type_t<typename A::key_type, S>;
+                position_list res(axis.size());
+                std::size_t first = 0;
+                for (std::size_t i = 0; i < res.size(); ++i)
+                {
+                    common_type last = static_cast<common_type>(axis.label(i));
+                    while (first < i && !(static_cast<common_type>(axis.label(first)) + static_cast<common_type>(m_span) > last))
+                    {
+                        ++first;
+                    }
+                    res[i] = first;
+                }
+                return res;
+            }
+
+            template <class A>
+            position_list build(const A&, std::false_type) const
+            {
+                throw std::invalid_argument("rolling_span: the labels and the span must be numbers");
+            }
+
+            S m_span;
+        };
+    }
+
+    /**
+     * Returns the moving windows of \c window positions along the specified
+     * dimension. Near the beginning of the dimension, windows are truncated.
+     * @param v the variable to aggregate.
+     * @param dim the name of the dimension.
+     * @param window the number of positions of a window.
+     * @param min_periods the minimal number of non-missing values of a
+     * window for its aggregate to be non-missing.
+     * @throw std::invalid_argument if window is 0.
+     */
+    template <class CCT, class ECT>
+    inline auto rolling(const xvariable_container<CCT, ECT>& v,
+                        const typename xvariable_container<CCT, ECT>::key_type& dim,
+                        std::size_t window, std::size_t min_periods)
+    {
+        if (window == 0)
+        {
+            throw std::invalid_argument("rolling: window must be positive");
+        }
+        std::size_t dimension = v.dimension_mapping()[dim];
+        std::vector<std::size_t> begins(v.shape()[dimension]);
+        for (std::size_t i = 0; i < begins.size(); ++i)
+        {
+            begins[i] = i + 1 > window ? i + 1 - window : std::size_t(0);
+        }
+        return xvariable_window<xvariable_container<CCT, ECT>>(v, dimension, std::move(begins), min_periods);
+    }
+
+    /**
+     * Returns the moving windows along the specified dimension, where the
+     * window of a position holds the positions whose labels are in
+     * (label - span, label].
+     * @param v the variable to aggregate.
+     * @param dim the name of the dimension; its axis must be sorted and its
+     * labels must be numbers.
+     * @param span the width of a window, in units of the labels.
+     * @param min_periods the minimal number of non-missing values of a
+     * window for its aggregate to be non-missing.
+     * @throw std::invalid_argument if the axis is not sorted or if its labels
+     * are not numbers.
+     */
+    template <class CCT, class ECT, class S>
+    inline auto rolling_span(const xvariable_container<CCT, ECT>& v,
+                             const typename xvariable_container<CCT, ECT>::key_type& dim,
+                             const S& span, std::size_t min_periods)
+    {
+        std::size_t dimension = v.dimension_mapping()[dim];
+        auto begins = xtl::visit(detail::xwindow_span_builder<S>(span), v.coordinates()[dim].storage());
+        return xvariable_window<xvariable_container<CCT, ECT>>(v, dimension, std::move(begins), min_periods);
+    }
+
+    /**
+     * Returns the expanding windows along the specified dimension: the
+     * window of a position holds all the previous positions.
+     * @param v the variable to aggregate.
+     * @param dim the name of the dimension.
+     * @param min_periods the minimal number of non-missing values of a
+     * window for its aggregate to be non-missing.
+     */
+    template <class CCT, class ECT>
+    inline auto expanding(const xvariable_container<CCT, ECT>& v,
+                          const typename xvariable_container<CCT, ECT>::key_type& dim,
+                          std::size_t min_periods)
+    {
+        std::size_t dimension = v.dimension_mapping()[dim];
+        std::vector<std::size_t> begins(v.shape()[dimension], std::size_t(0));
+        return xvariable_window<xvariable_container<CCT, ECT>>(v, dimension, std::move(begins), min_periods);
+    }
+}
+
+#endif
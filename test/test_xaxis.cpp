@@ -258,6 +258,19 @@ namespace xf
         EXPECT_EQ(res3["b"], 3u);
         EXPECT_EQ(res3["d"], 4u);
         EXPECT_EQ(res3["e"], 5u);
+
+        axis_type a5({ "f", "c" });
+        axis_type res4;
+        bool t4 = merge_axes(res4, a1, a5);
+        EXPECT_FALSE(t4);
+        EXPECT_FALSE(res4.is_sorted());
+        EXPECT_EQ(res4.size(), 6u);
+        EXPECT_EQ(res4["a"], 0u);
+        EXPECT_EQ(res4["b"], 1u);
+        EXPECT_EQ(res4["d"], 2u);
+        EXPECT_EQ(res4["e"], 3u);
+        EXPECT_EQ(res4["c"], 4u);
+        EXPECT_EQ(res4["f"], 5u);
     }
 
     TEST(xaxis, intersect)
@@ -288,6 +301,26 @@ namespace xf
         EXPECT_FALSE(t4);
     }
 
+    TEST(xaxis, intersect_unsorted)
+    {
+        axis_type a1 = { "h", "c", "a", "b" };
+        axis_type a2 = { "b", "h", "x" };
+        axis_type tmp = a1;
+        bool t1 = intersect_axes(tmp, a2);
+        EXPECT_FALSE(t1);
+        EXPECT_EQ(tmp.size(), 2u);
+        EXPECT_EQ(tmp["h"], 0u);
+        EXPECT_EQ(tmp["b"], 1u);
+        EXPECT_FALSE(tmp.contains("c"));
+        EXPECT_FALSE(tmp.contains("a"));
+
+        axis_type a3 = { "h", "c", "a", "b", "e" };
+        tmp = a1;
+        bool t2 = intersect_axes(tmp, a3);
+        EXPECT_TRUE(t2);
+        EXPECT_EQ(tmp, a1);
+    }
+
     TEST(xaxis, filter)
     {
         axis_type a = { "a", "b", "d", "e" };
@@ -296,4 +329,57 @@ namespace xf
         EXPECT_EQ(a["a"], 0u);
         EXPECT_EQ(a["b"], 1u);
     }
+
+    TEST(xaxis, sorted_tag)
+    {
+        using saxis_type = xaxis<int, std::size_t, sorted_tag>;
+        saxis_type a = { 1, 3, 5, 7 };
+        EXPECT_TRUE(a.contains(5));
+        EXPECT_FALSE(a.contains(4));
+        EXPECT_FALSE(a.contains(8));
+        EXPECT_EQ(a[1], 0u);
+        EXPECT_EQ(a[7], 3u);
+        EXPECT_THROW(a[4], std::out_of_range);
+        EXPECT_EQ(a.find(5)->second, 2u);
+        EXPECT_EQ(a.find(6), a.cend());
+        EXPECT_THROW(saxis_type({ 3, 1 }), std::invalid_argument);
+
+        iaxis_type u = { 8, 2 };
+        bool t1 = a.merge(u);
+        EXPECT_FALSE(t1);
+        EXPECT_EQ(a.labels(), std::vector<int>({ 1, 2, 3, 5, 7, 8 }));
+
+        iaxis_type v = { 8, 3, 4 };
+        bool t2 = a.intersect(v);
+        EXPECT_FALSE(t2);
+        EXPECT_EQ(a.labels(), std::vector<int>({ 3, 8 }));
+        EXPECT_EQ(a[8], 1u);
+    }
+
+    TEST(xaxis, shared_labels)
+    {
+        axis_type a = { "a", "c", "d" };
+        axis_type b = a;
+        EXPECT_EQ(&(a.labels()), &(b.labels()));
+        EXPECT_EQ(a, b);
+
+        axis_type c = a;
+        EXPECT_TRUE(c.merge(a, b));
+        EXPECT_TRUE(c.intersect(b));
+        EXPECT_EQ(&(a.labels()), &(c.labels()));
+
+        axis_type empty;
+        EXPECT_TRUE(empty.merge(a));
+        EXPECT_EQ(&(a.labels()), &(empty.labels()));
+
+        axis_type d = { "b", "e" };
+        bool t = c.merge(d);
+        EXPECT_FALSE(t);
+        EXPECT_NE(&(a.labels()), &(c.labels()));
+        EXPECT_EQ(a.size(), 3u);
+        EXPECT_EQ(a["d"], 2u);
+        EXPECT_FALSE(a.contains("b"));
+        EXPECT_EQ(c.size(), 5u);
+        EXPECT_EQ(c["b"], 1u);
+    }
 }
@@ -164,6 +164,36 @@ namespace xf
         EXPECT_TRUE(t3);
     }
 
+    TEST(xaxis_default, merge_default)
+    {
+        axis_default_type a1(3);
+        axis_default_type a2(5);
+        bool t1 = a1.merge(a2);
+        EXPECT_FALSE(t1);
+        EXPECT_EQ(5u, a1.size());
+        EXPECT_EQ(a1, a2);
+
+        axis_default_type a3(5);
+        bool t2 = a1.merge(a2, a3);
+        EXPECT_TRUE(t2);
+        EXPECT_EQ(5u, a1.size());
+    }
+
+    TEST(xaxis_default, intersect_default)
+    {
+        axis_default_type a1(5);
+        axis_default_type a2(3);
+        bool t1 = a1.intersect(a2);
+        EXPECT_FALSE(t1);
+        EXPECT_EQ(3u, a1.size());
+        EXPECT_EQ(a1.labels(), label_type({ 0, 1, 2 }));
+
+        axis_default_type a3(4);
+        bool t2 = a1.intersect(a3);
+        EXPECT_TRUE(t2);
+        EXPECT_EQ(3u, a1.size());
+    }
+
     TEST(xaxis_default, filter)
     {
         axis_default_type a(36);
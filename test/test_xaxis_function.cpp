@@ -131,4 +131,26 @@ namespace xf
         xt::xarray<bool> val = array && mask;
         EXPECT_EQ(val, expected);
     }
+
+    TEST(xaxis_function, resolve_positions)
+    {
+        auto axis1 = named_axis(fstring("abs"), axis({0, 2, 5}));
+        auto axis2 = named_axis(fstring("ord"), axis({'a', 'c', 'i'}));
+        auto func = axis1 + 1 < 5 && not_equal(axis2, 'i');
+
+        std::array<std::size_t, 2> positions;
+        static_assert(decltype(func)::leaf_count == 2, "func should have two leaves");
+        func.resolve_positions(dimension_type({"ord", "abs"}), positions.data());
+        EXPECT_EQ(positions[0], 1u);
+        EXPECT_EQ(positions[1], 0u);
+
+        std::array<std::size_t, 2> index = {1, 2};
+        EXPECT_FALSE(func.element(index, positions.data()));
+        index = {1, 1};
+        EXPECT_TRUE(func.element(index, positions.data()));
+        index = {2, 1};
+        EXPECT_FALSE(func.element(index, positions.data()));
+
+        EXPECT_THROW(func.resolve_positions(dimension_type({"abs"}), positions.data()), std::runtime_error);
+    }
 }
@@ -67,4 +67,66 @@ namespace xf
         EXPECT_EQ(2u, a2);
         EXPECT_THROW(a[3], std::out_of_range);
     }
+
+    TEST(xaxis_variant, merge_default)
+    {
+        auto a1 = axis_variant_type(axis(3));
+        auto a2 = axis_variant_type(axis(5));
+        bool t1 = a1.merge(a2);
+        EXPECT_FALSE(t1);
+        EXPECT_EQ(a1, a2);
+
+        auto a3 = axis_variant_type(axis({ 1, 6 }));
+        bool t2 = a1.merge(a3);
+        EXPECT_FALSE(t2);
+        EXPECT_EQ(a1, axis_variant_type(axis({ 0, 1, 2, 3, 4, 6 })));
+    }
+
+    TEST(xaxis_variant, intersect_default)
+    {
+        auto a1 = axis_variant_type(axis(5));
+        auto a2 = axis_variant_type(axis(3));
+        bool t1 = a1.intersect(a2);
+        EXPECT_FALSE(t1);
+        EXPECT_EQ(a1, axis_variant_type(axis({ 0, 1, 2 })));
+
+        auto a3 = axis_variant_type(axis({ 1, 2, 6 }));
+        bool t2 = a1.intersect(a3);
+        EXPECT_FALSE(t2);
+        EXPECT_EQ(a1, axis_variant_type(axis({ 1, 2 })));
+    }
+
+    TEST(xaxis_variant, merge_with_default)
+    {
+        auto a1 = axis_variant_type(axis({ 2, 5, 7 }));
+        auto d = axis_variant_type(axis(4));
+        bool t1 = a1.merge(d);
+        EXPECT_FALSE(t1);
+        EXPECT_EQ(a1, axis_variant_type(axis({ 0, 1, 2, 3, 5, 7 })));
+
+        auto a2 = axis_variant_type(axis({ 3, 1, 8 }));
+        bool t2 = a2.intersect(d);
+        EXPECT_FALSE(t2);
+        EXPECT_EQ(a2, axis_variant_type(axis({ 3, 1 })));
+
+        EXPECT_EQ(axis_variant_type(axis(3)), axis_variant_type(axis({ 0, 1, 2 })));
+        EXPECT_NE(axis_variant_type(axis(3)), axis_variant_type(axis({ 0, 2, 1 })));
+    }
+
+    TEST(xaxis_variant, shares_labels)
+    {
+        auto a1 = axis_variant_type(axis({ 1, 2, 4 }));
+        auto a2 = a1;
+        auto a3 = axis_variant_type(axis({ 1, 2, 4 }));
+        EXPECT_TRUE(a1.shares_labels(a2));
+        EXPECT_FALSE(a1.shares_labels(a3));
+        EXPECT_TRUE(a1.merge(a2));
+
+        auto d1 = axis_variant_type(axis(3));
+        auto d2 = axis_variant_type(axis(3));
+        auto d3 = axis_variant_type(axis(4));
+        EXPECT_TRUE(d1.shares_labels(d2));
+        EXPECT_FALSE(d1.shares_labels(d3));
+        EXPECT_FALSE(d1.shares_labels(a1));
+    }
 }
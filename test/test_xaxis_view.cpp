@@ -164,4 +164,117 @@ namespace xf
         EXPECT_TRUE(vr != c);
         EXPECT_TRUE(c != vr);
     }
+
+    TEST(xaxis_view, between)
+    {
+        // { "a", "c", "d", "f", "g", "h", "m", "n" }
+        auto a = make_variant_view_saxis();
+
+        auto b = between("b", "e");
+        axis_view_type vb = axis_view_type(a, b.build_index_slice(a));
+        auto vbit = vb.cbegin();
+        EXPECT_EQ(xtl::xget<const fstring&>(vbit->first), "c");
+        ++vbit;
+        EXPECT_EQ(xtl::xget<const fstring&>(vbit->first), "d");
+        ++vbit;
+        EXPECT_EQ(vbit, vb.cend());
+
+        auto e = between("i", "j");
+        axis_view_type ve = axis_view_type(a, e.build_index_slice(a));
+        EXPECT_TRUE(ve.empty());
+    }
+
+    TEST(xaxis_view, asof)
+    {
+        // { "a", "c", "d", "f", "g", "h", "m", "n" }
+        auto a = make_variant_view_saxis();
+
+        auto bw = asof_backward("e");
+        axis_view_type vbw = axis_view_type(a, bw.build_index_slice(a));
+        EXPECT_EQ(vbw.size(), 1u);
+        EXPECT_EQ(xtl::xget<const fstring&>(vbw.cbegin()->first), "d");
+
+        auto fw = asof_forward("e");
+        axis_view_type vfw = axis_view_type(a, fw.build_index_slice(a));
+        EXPECT_EQ(vfw.size(), 1u);
+        EXPECT_EQ(xtl::xget<const fstring&>(vfw.cbegin()->first), "f");
+
+        auto ex = asof_forward("f");
+        axis_view_type vex = axis_view_type(a, ex.build_index_slice(a));
+        EXPECT_EQ(xtl::xget<const fstring&>(vex.cbegin()->first), "f");
+
+        EXPECT_ANY_THROW(asof_backward("0").build_index_slice(a));
+        EXPECT_ANY_THROW(asof_forward("z").build_index_slice(a));
+        EXPECT_ANY_THROW(nearest("e").build_index_slice(a));
+    }
+
+    TEST(xaxis_view, nearest)
+    {
+        // { 1, 2, 4, 5, 6, 8, 12, 13 }
+        auto a = axis_variant(make_test_view_iaxis());
+
+        auto n1 = nearest(10);
+        axis_view_type vn1 = axis_view_type(a, n1.build_index_slice(a));
+        EXPECT_EQ(vn1.size(), 1u);
+        EXPECT_EQ(xtl::xget<const int&>(vn1.cbegin()->first), 8);
+
+        auto n2 = nearest(11);
+        axis_view_type vn2 = axis_view_type(a, n2.build_index_slice(a));
+        EXPECT_EQ(xtl::xget<const int&>(vn2.cbegin()->first), 12);
+
+        auto n3 = nearest(42);
+        axis_view_type vn3 = axis_view_type(a, n3.build_index_slice(a));
+        EXPECT_EQ(xtl::xget<const int&>(vn3.cbegin()->first), 13);
+    }
+
+    TEST(xaxis_view, locate_label_search)
+    {
+        // abscissa: { "a", "c", "d", "f", "g", "h", "m", "n" }
+        // ordinate: { 1, 2, 4, 5, 6, 8, 12, 13 }
+        variable_type var = make_test_view_variable();
+
+        variable_view_type vb = locate(var, between("b", "e"), between(3, 7));
+        variable_view_type vbr = locate(var, range("c", "d"), range(4, 6));
+        EXPECT_EQ(vb, vbr);
+        EXPECT_EQ(vb.locate("c", 5), var.locate("c", 5));
+
+        variable_view_type vbw = locate(var, asof_backward("e"), asof_backward(7));
+        EXPECT_EQ(vbw.size(), 1u);
+        EXPECT_EQ(vbw, locate(var, range("d", "d"), range(6, 6)));
+
+        variable_view_type vfw = locate(var, asof_forward("e"), asof_forward(4));
+        EXPECT_EQ(vfw.size(), 1u);
+        EXPECT_EQ(vfw.locate("f", 4), var.locate("f", 4));
+
+        variable_view_type vn = locate(var, all(), nearest(11));
+        EXPECT_EQ(vn, locate(var, all(), range(12, 12)));
+
+        variable_view_type ve = locate(var, between("i", "j"), all());
+        EXPECT_EQ(ve.size(), 0u);
+
+        EXPECT_ANY_THROW(locate(var, asof_backward("0"), all()));
+        EXPECT_ANY_THROW(locate(var, all(), asof_forward(42)));
+    }
+
+    TEST(xaxis_view, select_label_search)
+    {
+        // abscissa: { "a", "c", "d", "f", "g", "h", "m", "n" }
+        // ordinate: { 1, 2, 4, 5, 6, 8, 12, 13 }
+        variable_type var = make_test_view_variable();
+
+        variable_view_type vb = select(var, {{"abscissa", between("b", "e")}, {"ordinate", between(3, 7)}});
+        EXPECT_EQ(vb, locate(var, range("c", "d"), range(4, 6)));
+
+        variable_view_type vs = select(var, {{"abscissa", asof_backward("e")}, {"ordinate", nearest(10)}});
+        EXPECT_EQ(vs, locate(var, range("d", "d"), range(8, 8)));
+        EXPECT_EQ(vs.locate("d", 8), var.locate("d", 8));
+
+        variable_view_type vf = select(var, {{"abscissa", asof_forward("i")}});
+        EXPECT_EQ(vf, locate(var, range("m", "m"), all()));
+
+        variable_view_type ve = select(var, {{"ordinate", between(9, 11)}});
+        EXPECT_EQ(ve.size(), 0u);
+
+        EXPECT_ANY_THROW(select(var, {{"abscissa", asof_forward("z")}}));
+    }
 }
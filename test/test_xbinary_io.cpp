@@ -0,0 +1,155 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include "gtest/gtest.h"
+#include "xframe/xbinary_io.hpp"
+#include "test_fixture.hpp"
+
+namespace xf
+{
+    TEST(xbinary_io, save_load)
+    {
+        const std::string path = "xframe_test_save_load.xfb";
+        auto v = make_test_variable();
+        save(v, path);
+
+        auto res = load<variable_type>(path);
+        std::remove(path.c_str());
+
+        EXPECT_EQ(res.coordinates(), v.coordinates());
+        EXPECT_EQ(res.dimension_mapping(), v.dimension_mapping());
+        EXPECT_EQ(res.data(), v.data());
+        EXPECT_FALSE(res.locate("a", 4).has_value());
+        EXPECT_EQ(res.locate("d", 2).value(), 8.);
+    }
+
+    TEST(xbinary_io, default_axis)
+    {
+        const std::string path = "xframe_test_default_axis.xfb";
+        data_type d = { 1., 2., 3. };
+        coordinate_type c = {{ "abscissa", make_test_daxis() }};
+        variable_type v(std::move(d), std::move(c), dimension_type({ "abscissa" }));
+        save(v, path);
+
+        auto res = load<variable_type>(path);
+        std::remove(path.c_str());
+        EXPECT_EQ(res.coordinates(), v.coordinates());
+        EXPECT_EQ(res.locate(2).value(), 3.);
+    }
+
+    TEST(xbinary_io, load_errors)
+    {
+        const std::string path = "xframe_test_load_errors.xfb";
+        EXPECT_THROW(load<variable_type>(path), std::runtime_error);
+
+        save(make_test_variable(), path);
+        EXPECT_THROW(load<int_variable_type>(path), std::runtime_error);
+
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << "not a variable";
+        }
+        EXPECT_THROW(load<variable_type>(path), std::runtime_error);
+        std::remove(path.c_str());
+    }
+
+    namespace
+    {
+        // Overwrites a 64-bit field of the header of a saved file.
+        void patch_binary_header(const std::string& path, std::streamoff offset, std::uint64_t value)
+        {
+            std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+            f.seekp(offset);
+            f.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        std::uint64_t read_binary_header(const std::string& path, std::streamoff offset)
+        {
+            std::uint64_t value = 0;
+            std::ifstream f(path, std::ios::binary);
+            f.seekg(offset);
+            f.read(reinterpret_cast<char*>(&value), sizeof(value));
+            return value;
+        }
+    }
+
+    TEST(xbinary_io, load_corrupted)
+    {
+        const std::string path = "xframe_test_load_corrupted.xfb";
+        // Offsets of m_mask_offset and m_size in the header.
+        const std::streamoff mask_offset = 24;
+        const std::streamoff size_offset = 32;
+
+        save(make_test_variable(), path);
+        patch_binary_header(path, size_offset, 1000u);
+        EXPECT_THROW(load<variable_type>(path), std::runtime_error);
+#if XFRAME_HAS_MMAP
+        EXPECT_THROW((load_mapped<double, coordinate_type>(path)), std::runtime_error);
+#endif
+
+        save(make_test_variable(), path);
+        patch_binary_header(path, mask_offset, std::uint64_t(1) << 40);
+        EXPECT_THROW(load<variable_type>(path), std::runtime_error);
+#if XFRAME_HAS_MMAP
+        EXPECT_THROW((load_mapped<double, coordinate_type>(path)), std::runtime_error);
+#endif
+        std::remove(path.c_str());
+    }
+
+#if XFRAME_HAS_MMAP
+    TEST(xbinary_io, load_mapped)
+    {
+        const std::string path = "xframe_test_load_mapped.xfb";
+        auto v = make_test_variable();
+        save(v, path);
+
+        {
+            auto mapped = load_mapped<double, coordinate_type>(path);
+            const auto& res = mapped.variable();
+            EXPECT_EQ(res.coordinates(), v.coordinates());
+            EXPECT_EQ(res.dimension_mapping(), v.dimension_mapping());
+            EXPECT_EQ(res.locate("a", 1).value(), 1.);
+            EXPECT_FALSE(res.locate("a", 4).has_value());
+            EXPECT_EQ(res.locate("d", 4).value(), 9.);
+
+            mapped.variable().locate("d", 4).value() = 10.;
+            EXPECT_EQ(res.locate("d", 4).value(), 10.);
+        }
+
+        auto reloaded = load<variable_type>(path);
+        std::remove(path.c_str());
+        EXPECT_EQ(reloaded.locate("d", 4).value(), 9.);
+    }
+
+    TEST(xbinary_io, load_mapped_invalid)
+    {
+        const std::string path = "xframe_test_load_mapped_invalid.xfb";
+        // Offsets of m_values_offset and m_mask_offset in the header.
+        const std::streamoff values_offset = 16;
+        const std::streamoff mask_offset = 24;
+
+        save(make_test_variable(), path);
+        patch_binary_header(path, values_offset, read_binary_header(path, values_offset) + 1u);
+        EXPECT_THROW((load_mapped<double, coordinate_type>(path)), std::runtime_error);
+
+        save(make_test_variable(), path);
+        {
+            std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+            f.seekp(static_cast<std::streamoff>(read_binary_header(path, mask_offset)));
+            f.put(char(2));
+        }
+        EXPECT_THROW((load_mapped<double, coordinate_type>(path)), std::runtime_error);
+        std::remove(path.c_str());
+    }
+#endif
+}
@@ -0,0 +1,106 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "xframe/xbitset_mask.hpp"
+#include "xframe/xvariable_reducer.hpp"
+#include "test_fixture.hpp"
+
+namespace xf
+{
+    using bitset_data_type = xbitset_optional<double>;
+    using bitset_variable_type = xvariable_container<coordinate_type, bitset_data_type>;
+
+    inline bitset_variable_type make_test_bitset_variable()
+    {
+        bitset_data_type d(make_test_data());
+        return bitset_variable_type(std::move(d), make_test_coordinate(), dimension_type({"abscissa", "ordinate"}));
+    }
+
+    TEST(xbitset_mask, access)
+    {
+        auto v = make_test_bitset_variable();
+        EXPECT_EQ(v.locate("a", 1).value(), 1.);
+        EXPECT_FALSE(v.locate("a", 4).has_value());
+        EXPECT_FALSE(v.locate("c", 1).has_value());
+        EXPECT_TRUE(v.locate("d", 4).has_value());
+
+        v.locate("d", 4).has_value() = false;
+        EXPECT_FALSE(v.locate("d", 4).has_value());
+        EXPECT_TRUE(v.locate("d", 2).has_value());
+    }
+
+    TEST(xbitset_mask, all_valid)
+    {
+        auto v = make_test_bitset_variable();
+        EXPECT_FALSE(all_valid(v.data().has_value()));
+        v.locate("a", 4).has_value() = true;
+        v.locate("c", 1).has_value() = true;
+        EXPECT_TRUE(all_valid(v.data().has_value()));
+
+        auto w = make_test_variable();
+        EXPECT_FALSE(all_valid(w.data().has_value()));
+    }
+
+    TEST(xbitset_mask, arithmetic)
+    {
+        auto a = make_test_bitset_variable();
+        auto b = make_test_bitset_variable();
+        b.locate("d", 4).has_value() = false;
+
+        bitset_variable_type res = a + b;
+        EXPECT_EQ(res.locate("a", 1).value(), 2.);
+        EXPECT_EQ(res.locate("d", 2).value(), 16.);
+        EXPECT_FALSE(res.locate("a", 4).has_value());
+        EXPECT_FALSE(res.locate("c", 1).has_value());
+        EXPECT_FALSE(res.locate("d", 4).has_value());
+        EXPECT_TRUE(res.locate("c", 2).has_value());
+
+        a = a * b;
+        EXPECT_EQ(a.locate("d", 2).value(), 64.);
+        EXPECT_FALSE(a.locate("d", 4).has_value());
+        EXPECT_TRUE(a.locate("d", 2).has_value());
+    }
+
+    TEST(xbitset_mask, where)
+    {
+        auto a = make_test_bitset_variable();
+        auto b = make_test_bitset_variable();
+        b.locate("a", 2).has_value() = false;
+        b.locate("d", 4).has_value() = false;
+
+        bitset_variable_type res = where(a < 5., b, a);
+        EXPECT_EQ(res.locate("a", 1).value(), 1.);
+        EXPECT_FALSE(res.locate("a", 2).has_value());
+        EXPECT_FALSE(res.locate("a", 4).has_value());
+        EXPECT_EQ(res.locate("c", 2).value(), 5.);
+        EXPECT_TRUE(res.locate("d", 4).has_value());
+        EXPECT_EQ(res.locate("d", 4).value(), 9.);
+    }
+
+    TEST(xbitset_mask, reducers)
+    {
+        auto v = make_test_bitset_variable();
+        auto s = xf::sum(v, { "ordinate" });
+        EXPECT_EQ(s.locate("a").value(), 3.);
+        EXPECT_EQ(s.locate("c").value(), 11.);
+        EXPECT_EQ(s.locate("d").value(), 24.);
+
+        auto c = xf::count(v, { "abscissa" });
+        EXPECT_EQ(c.locate(1).value(), 2u);
+        EXPECT_EQ(c.locate(2).value(), 3u);
+
+        v.locate("a", 4).has_value() = true;
+        v.locate("c", 1).has_value() = true;
+        auto m = xf::mean(v, { "ordinate" });
+        EXPECT_EQ(m.locate("a").value(), 2.);
+        EXPECT_EQ(m.locate("c").value(), 5.);
+    }
+}
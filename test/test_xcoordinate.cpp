@@ -118,6 +118,7 @@ namespace xf
         EXPECT_TRUE(res1.m_same_dimensions);
         EXPECT_TRUE(res1.m_same_labels);
         EXPECT_EQ(c1, cres1);
+        EXPECT_TRUE(cres1["abscissa"].shares_labels(c1["abscissa"]));
 
         auto c2 = make_test_coordinate3();
         decltype(c2) cres2;
@@ -0,0 +1,119 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include "gtest/gtest.h"
+#include "xframe/xcsv_reader.hpp"
+#include "test_fixture.hpp"
+
+namespace xf
+{
+    namespace
+    {
+        void write_test_csv(const std::string& path, const std::string& content)
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << content;
+        }
+
+        const std::string test_csv =
+            "abscissa,ordinate,comment,value\n"
+            "a,1,x,1\n"
+            "a,2,x,2.0\n"
+            "a,4,x,NA\n"
+            "c,2,x,0.5e1\n"
+            "c,4,x,6\r\n"
+            "\n"
+            "d,1,x,7\n"
+            "d,2,x,80e-1\n"
+            "d,4,x,9.";
+    }
+
+    TEST(xcsv_reader, read_csv)
+    {
+        const std::string path = "xframe_test_read_csv.csv";
+        write_test_csv(path, test_csv);
+
+        xcsv_stats stats;
+        auto res = read_csv<variable_type>(path, { "abscissa", "ordinate" }, "value", xcsv_options(), &stats);
+        std::remove(path.c_str());
+
+        auto v = make_test_variable();
+        EXPECT_EQ(res.coordinates(), v.coordinates());
+        EXPECT_EQ(res.dimension_mapping(), v.dimension_mapping());
+        for (auto a : { "a", "c", "d" })
+        {
+            for (int o : { 1, 2, 4 })
+            {
+                EXPECT_EQ(res.locate(a, o), v.locate(a, o));
+            }
+        }
+        EXPECT_EQ(stats.m_rows, 8u);
+    }
+
+    TEST(xcsv_reader, small_chunks)
+    {
+        const std::string path = "xframe_test_small_chunks.csv";
+        write_test_csv(path, test_csv);
+
+        xcsv_options options;
+        options.m_chunk_size = 4;
+        auto res = read_csv<variable_type>(path, { "ordinate", "abscissa" }, "value", options);
+        std::remove(path.c_str());
+
+        EXPECT_EQ(res.dimension_labels()[0], "ordinate");
+        EXPECT_EQ(res.locate(2, "c").value(), 5.);
+        EXPECT_FALSE(res.locate(1, "c").has_value());
+        EXPECT_FALSE(res.locate(4, "a").has_value());
+    }
+
+    TEST(xcsv_reader, separator)
+    {
+        const std::string path = "xframe_test_separator.csv";
+        write_test_csv(path, "value;abscissa\n-1;a\n3;b\n");
+
+        xcsv_options options;
+        options.m_separator = ';';
+        auto res = read_csv<int_variable_type>(path, { "abscissa" }, "value", options);
+        EXPECT_EQ(res.locate("a").value(), -1);
+        EXPECT_EQ(res.locate("b").value(), 3);
+
+        write_test_csv(path, "value;abscissa\n3.25;a\n");
+        EXPECT_THROW(read_csv<int_variable_type>(path, { "abscissa" }, "value", options), std::runtime_error);
+        std::remove(path.c_str());
+    }
+
+    TEST(xcsv_reader, duplicate_labels)
+    {
+        const std::string path = "xframe_test_csv_duplicates.csv";
+        write_test_csv(path, "abscissa,value\na,1\nb,2\na,3\nb,4\nb,NA\na,5\n");
+
+        xcsv_options options;
+        options.m_chunk_size = 2;
+        auto res = read_csv<variable_type>(path, { "abscissa" }, "value", options);
+        std::remove(path.c_str());
+
+        EXPECT_EQ(res.locate("a").value(), 5.);
+        EXPECT_FALSE(res.locate("b").has_value());
+    }
+
+    TEST(xcsv_reader, errors)
+    {
+        const std::string path = "xframe_test_csv_errors.csv";
+        write_test_csv(path, "abscissa,value\na,1\nb,x\n");
+        EXPECT_THROW(read_csv<variable_type>(path, { "ordinate" }, "value"), std::invalid_argument);
+        EXPECT_THROW(read_csv<variable_type>(path, { "abscissa" }, "value"), std::runtime_error);
+
+        write_test_csv(path, "abscissa,value\na\n");
+        EXPECT_THROW(read_csv<variable_type>(path, { "abscissa" }, "value"), std::runtime_error);
+        std::remove(path.c_str());
+    }
+}
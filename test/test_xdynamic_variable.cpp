@@ -374,4 +374,62 @@ ordinate: (1, 2, 4, )
         std::string res = oss.str();
         EXPECT_EQ(res, expected);
     }
+
+    TEST(xdynamic_variable, get)
+    {
+        auto v = make_test_variable();
+        auto dv = make_dynamic(v);
+
+        EXPECT_EQ(dv.get_if<int_variable_type>(), nullptr);
+        EXPECT_THROW(dv.get<int_variable_type>(), std::bad_cast);
+
+        variable_type& tv = dv.get<variable_type>();
+        EXPECT_EQ(tv, v);
+        tv.locate("d", 4) = 12.;
+        EXPECT_EQ(opt_cast(dv.locate("d", 4)), 12.);
+
+        const auto& cdv = dv;
+        EXPECT_EQ(cdv.get_if<variable_type>(), &tv);
+    }
+
+    TEST(xdynamic_variable, visit_data)
+    {
+        auto v = make_test_variable();
+        auto dv = make_dynamic<double>(v);
+
+        double sum = 0.;
+        bool found = dv.visit_data<int_variable_type, variable_type>([&sum](const auto& tv)
+        {
+            for (const auto& val : tv.data())
+            {
+                if (val.has_value())
+                {
+                    sum += val.value();
+                }
+            }
+        });
+        EXPECT_TRUE(found);
+        EXPECT_EQ(sum, 38.);
+
+        found = dv.visit_data<int_variable_type>([&sum](const auto&) { sum = 0.; });
+        EXPECT_FALSE(found);
+        EXPECT_EQ(sum, 38.);
+    }
+
+    TEST(xdynamic_variable, copy_to)
+    {
+        auto v = make_test_variable();
+        auto dv = make_dynamic(v);
+
+        std::vector<double> values(dv.size());
+        bool mask[9];
+        dv.copy_to(values.data(), mask);
+        EXPECT_EQ(values[1], 2.);
+        EXPECT_EQ(values[8], 9.);
+        EXPECT_FALSE(mask[2]);
+        EXPECT_TRUE(mask[4]);
+
+        std::vector<int> ints(dv.size());
+        EXPECT_THROW(dv.copy_to(ints.data()), std::bad_cast);
+    }
 }
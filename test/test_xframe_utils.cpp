@@ -39,6 +39,19 @@ namespace xf
         bool res4 = merge_to(v1, v5);
         EXPECT_EQ(v1, vres);
         EXPECT_FALSE(res4);
+
+        std::vector<int> v6 = { 2, 6, 8 };
+        std::vector<int> v7 = { 1, 8, 12 };
+        std::vector<int> v8 = { 0, 12 };
+        std::vector<int> vres2 = { 0, 1, 2, 6, 8, 12 };
+        bool res5 = merge_to(v6, v7, v8);
+        EXPECT_EQ(v6, vres2);
+        EXPECT_FALSE(res5);
+
+        auto v9 = vres2;
+        bool res6 = merge_to(v6, v9, vres2);
+        EXPECT_EQ(v6, vres2);
+        EXPECT_TRUE(res6);
     }
 
     TEST(xframe_utils, intersect_to)
@@ -0,0 +1,128 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include "gtest/gtest.h"
+#include "xframe/xinterned_string.hpp"
+#include "xframe/xaxis.hpp"
+
+namespace xf
+{
+    TEST(xinterned_string, constructor)
+    {
+        istring s0;
+        EXPECT_TRUE(s0.empty());
+        EXPECT_EQ(s0.size(), 0u);
+
+        istring s1 = "symbol";
+        istring s2 = std::string("symbol");
+        EXPECT_EQ(s1.id(), s2.id());
+        EXPECT_EQ(s1.str(), "symbol");
+        EXPECT_EQ(std::string(s2.c_str()), "symbol");
+        EXPECT_EQ(s1.size(), 6u);
+        EXPECT_FALSE(s1.empty());
+        EXPECT_EQ(sizeof(istring), 4u);
+    }
+
+    TEST(xinterned_string, comparison)
+    {
+        istring a = "venue_a";
+        istring b = "venue_b";
+        istring a2 = "venue_a";
+
+        EXPECT_TRUE(a == a2);
+        EXPECT_FALSE(a != a2);
+        EXPECT_TRUE(a != b);
+        EXPECT_TRUE(a == "venue_a");
+
+        EXPECT_TRUE(a < b);
+        EXPECT_TRUE(a <= b);
+        EXPECT_TRUE(a <= a2);
+        EXPECT_TRUE(b > a);
+        EXPECT_TRUE(b >= a);
+        EXPECT_FALSE(a < a2);
+
+        // Ordering is lexicographic, not the order of interning
+        istring z = "zz_interned_first";
+        istring y = "yy_interned_second";
+        EXPECT_TRUE(y < z);
+    }
+
+    TEST(xinterned_string, hash)
+    {
+        std::unordered_set<istring> s = { "a", "b", "a" };
+        EXPECT_EQ(s.size(), 2u);
+        EXPECT_EQ(std::hash<istring>()(istring("a")), std::hash<istring>()(istring("a")));
+    }
+
+    TEST(xinterned_string, print)
+    {
+        std::ostringstream oss;
+        oss << istring("symbol");
+        EXPECT_EQ(oss.str(), "symbol");
+    }
+
+    TEST(xinterned_string, axis)
+    {
+        using axis_type = xaxis<istring, std::size_t>;
+        axis_type a = { "c", "a", "b" };
+        EXPECT_EQ(a["c"], 0u);
+        EXPECT_EQ(a["a"], 1u);
+        EXPECT_EQ(a["b"], 2u);
+        EXPECT_FALSE(a.contains("d"));
+        EXPECT_FALSE(a.is_sorted());
+
+        axis_type b = { "a", "b", "d" };
+        EXPECT_TRUE(b.is_sorted());
+        axis_type res = b;
+        res.merge(axis_type({ "c" }));
+        EXPECT_EQ(res.size(), 4u);
+        EXPECT_EQ(res["c"], 2u);
+        EXPECT_EQ(res["d"], 3u);
+    }
+
+    TEST(xinterned_string, lookup)
+    {
+        std::size_t size = xstring_pool::instance().size();
+        istring k = istring::lookup("lookup_never_interned");
+        EXPECT_FALSE(k.valid());
+        EXPECT_EQ(xstring_pool::instance().size(), size);
+        EXPECT_NE(k, istring());
+        EXPECT_TRUE(istring() < k);
+        EXPECT_FALSE(k < istring());
+
+        istring s = "lookup_interned";
+        istring k2 = istring::lookup(std::string("lookup_interned"));
+        EXPECT_TRUE(k2.valid());
+        EXPECT_EQ(k2, s);
+    }
+
+    TEST(xinterned_string, axis_lookup)
+    {
+        using axis_type = xaxis<istring, std::size_t>;
+        axis_type a = { "c", "a", "b" };
+        std::size_t size = xstring_pool::instance().size();
+        EXPECT_FALSE(a.contains("axis_never_interned"));
+        EXPECT_EQ(a.find(std::string("axis_never_interned")), a.cend());
+        EXPECT_THROW(a["axis_never_interned"], std::out_of_range);
+        EXPECT_EQ(a["b"], 2u);
+        EXPECT_EQ(xstring_pool::instance().size(), size);
+
+        using sorted_axis_type = xaxis<istring, std::size_t, sorted_tag>;
+        sorted_axis_type sa = { "", "a", "b" };
+        EXPECT_FALSE(sa.contains("axis_never_interned"));
+        EXPECT_EQ(sa[""], 0u);
+        EXPECT_EQ(xstring_pool::instance().size(), size);
+    }
+}
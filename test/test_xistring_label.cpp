@@ -0,0 +1,85 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+// Built in its own test executable with XFRAME_STRING_LABEL=xf::istring.
+
+#include <cstddef>
+#include <type_traits>
+#include "gtest/gtest.h"
+
+#include "xframe/xframe_config.hpp"
+#include "xframe/xvariable.hpp"
+
+namespace xf
+{
+    static_assert(std::is_same<XFRAME_STRING_LABEL, istring>::value,
+                  "test_xistring_label requires XFRAME_STRING_LABEL=xf::istring");
+
+    using isaxis_type = xaxis<istring, std::size_t>;
+    using iaxis_type = xaxis<int, std::size_t>;
+    using dimension_type = xdimension<fstring, std::size_t>;
+    using data_type = xt::xoptional_assembly<xt::xarray<double>, xt::xarray<bool>>;
+    using coordinate_type = xcoordinate<fstring>;
+    using variable_type = xvariable_container<coordinate_type, data_type>;
+
+    // abscissa: { "a", "c", "d" }
+    // ordinate: { 1, 2, 4 }
+    inline variable_type make_istring_variable()
+    {
+        data_type d = {{ 1., 2., 3.},
+                       { 4., 5., 6.},
+                       { 7., 8., 9.}};
+        auto c = coordinate<fstring>({
+            {fstring("abscissa"), isaxis_type({ "a", "c", "d" })},
+            {fstring("ordinate"), iaxis_type({ 1, 2, 4 })}
+        });
+        return variable_type(std::move(d), std::move(c), dimension_type({"abscissa", "ordinate"}));
+    }
+
+    TEST(xistring_label, select)
+    {
+        auto v = make_istring_variable();
+        EXPECT_EQ(v.select({{"abscissa", "a"}, {"ordinate", 1}}), v(0, 0));
+        EXPECT_EQ(v.select({{"abscissa", "c"}, {"ordinate", 2}}), v(1, 1));
+        EXPECT_EQ(v.select({{"abscissa", "d"}, {"ordinate", 4}}), v(2, 2));
+
+        std::size_t size = xstring_pool::instance().size();
+        EXPECT_ANY_THROW(v.select({{"abscissa", istring::lookup("select_never_interned")}, {"ordinate", 1}}));
+        EXPECT_ANY_THROW(v.select({{"abscissa", "select_literal_never_interned"}, {"ordinate", 1}}));
+        EXPECT_EQ(xstring_pool::instance().size(), size);
+    }
+
+    TEST(xistring_label, locate)
+    {
+        auto v = make_istring_variable();
+        EXPECT_EQ(v.locate("a", 1), v(0, 0));
+        EXPECT_EQ(v.locate("d", 4), v(2, 2));
+
+        std::size_t size = xstring_pool::instance().size();
+        EXPECT_ANY_THROW(v.locate("locate_never_interned", 1));
+        EXPECT_EQ(xstring_pool::instance().size(), size);
+    }
+
+    TEST(xistring_label, merge)
+    {
+        auto v1 = make_istring_variable();
+        data_type d = {{ 10., 20., 30.},
+                       { 40., 50., 60.}};
+        auto c = coordinate<fstring>({
+            {fstring("abscissa"), isaxis_type({ "c", "e" })},
+            {fstring("ordinate"), iaxis_type({ 1, 2, 4 })}
+        });
+        variable_type v2(std::move(d), std::move(c), dimension_type({"abscissa", "ordinate"}));
+
+        variable_type res = v1 + v2;
+        EXPECT_EQ(res.coordinates()["abscissa"].size(), 1u);
+        EXPECT_EQ(res.select({{"abscissa", "c"}, {"ordinate", 2}}), v1(1, 1) + v2(0, 1));
+    }
+}
@@ -8,6 +8,7 @@
 * The full license is in the file LICENSE, distributed with this software. *
 ****************************************************************************/
 
+#include <algorithm>
 #include <string>
 #include "gtest/gtest.h"
 
@@ -21,9 +22,18 @@ namespace xf
         auto n_a = named_axis("axis_a", a);
         auto labels = get_labels<int>(n_a);
 
-        EXPECT_EQ(labels, a.labels());
+        auto a_labels = a.labels();
+        EXPECT_TRUE(std::equal(labels.begin(), labels.end(), a_labels.begin(), a_labels.end()));
         EXPECT_EQ(0, labels[0]);
         EXPECT_EQ(56u, labels.size());
+        EXPECT_EQ(12, n_a.label(12));
+
+        auto s = axis({ 'a', 'c', 'd' });
+        auto n_s = named_axis("axis_s", s);
+        auto s_labels = get_labels<char>(n_s);
+        EXPECT_EQ(3u, s_labels.size());
+        EXPECT_EQ('c', s_labels[1]);
+        EXPECT_EQ('d', n_s.label(2));
     }
 
     TEST(xnamed_axis, name)
@@ -128,6 +128,26 @@ namespace xf
         EXPECT_EQ(view.element({3, 2}), 9);
     }
 
+    TEST(xreindex_view, element_contiguous)
+    {
+        auto missing = xtl::missing<double>();
+        using data_type = xt::xoptional_assembly<xt::xarray<double>, xt::xarray<bool>>;
+        auto var = make_test_variable();
+
+        auto view = reindex(var, {{"abscissa", xf::axis({"c", "d"})}});
+        EXPECT_EQ(view.element({0, 0}), 4.);
+        EXPECT_EQ(view.element({1, 2}), 9.);
+        data_type exp = {{4., 5., 6.}, {7., 8., 9.}};
+        EXPECT_EQ(view.data(), exp);
+
+        auto view2 = reindex(var, {{"abscissa", xf::axis({"d", "b", "a"})}});
+        EXPECT_EQ(view2.element({0, 0}), 7.);
+        EXPECT_EQ(view2.element({1, 1}), view2.missing());
+        EXPECT_EQ(view2.iselect({{"abscissa", 2}, {"ordinate", 1}}), 2.);
+        data_type exp2 = {{7., 8., 9.}, {missing, missing, missing}, {1., 2., 3.}};
+        EXPECT_EQ(view2.data(), exp2);
+    }
+
     TEST(xreindex_view, locate)
     {
         auto var = make_test_variable();
@@ -325,4 +345,29 @@ namespace xf
         EXPECT_EQ(std::get<0>(res).data(), exp0);
         EXPECT_EQ(std::get<1>(res).data(), exp1);
     }
+
+    TEST(xreindex_view, align_copy)
+    {
+        auto missing = xtl::missing<double>();
+        using data_type = xt::xoptional_assembly<xt::xarray<double>, xt::xarray<bool>>;
+        auto var = make_test_variable();
+        auto var3 = make_test_variable3();
+
+        auto res = align_copy<join::inner>(var, var3);
+        auto coord = coordinate<fstring>({
+                {fstring("abscissa"), saxis_type({"a", "d"})},
+                {fstring("ordinate"), iaxis_type({1, 4})}
+        });
+        EXPECT_EQ(std::get<0>(res).coordinates(), coord);
+        EXPECT_EQ(std::get<1>(res).coordinates(), coord);
+        data_type exp0 = {{1., missing}, {7., 9.}};
+        data_type exp1 = {{1., 2.}, {missing, 5.}};
+        EXPECT_EQ(std::get<0>(res).data(), exp0);
+        EXPECT_EQ(std::get<1>(res).data(), exp1);
+
+        auto res2 = align_copy<join::outer>(var, var);
+        EXPECT_EQ(std::get<0>(res2).coordinates(), var.coordinates());
+        EXPECT_EQ(std::get<0>(res2).data(), var.data());
+        EXPECT_EQ(std::get<1>(res2).data(), var.data());
+    }
 }
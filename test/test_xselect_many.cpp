@@ -0,0 +1,71 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "xframe/xselect_many.hpp"
+#include "test_fixture.hpp"
+
+namespace xf
+{
+    //                 ordinate
+    //                1,   2,   4
+    //            a {{1,   2, N/A},
+    // abscissa   c  {N/A, 5,   6},
+    //            d  {7,   8,   9}}
+
+    TEST(xselect_many, select_many)
+    {
+        auto v = make_test_variable();
+        std::vector<fstring> abscissa = { "d", "a", "c", "a" };
+        std::vector<int> ordinate = { 1, 2, 4, 4 };
+
+        auto res = select_many(v, { { "abscissa", abscissa }, { "ordinate", ordinate } });
+        ASSERT_EQ(res.size(), 4u);
+        EXPECT_EQ(res.value()(0), 7.);
+        EXPECT_EQ(res.value()(1), 2.);
+        EXPECT_EQ(res.value()(2), 6.);
+        EXPECT_TRUE(res.has_value()(0));
+        EXPECT_TRUE(res.has_value()(1));
+        EXPECT_TRUE(res.has_value()(2));
+        EXPECT_FALSE(res.has_value()(3));
+
+        std::vector<fstring> unknown = { "b", "a", "c", "d" };
+        EXPECT_THROW(select_many(v, { { "abscissa", unknown }, { "ordinate", ordinate } }), std::out_of_range);
+
+        auto outer = select_many<join::outer>(v, { { "abscissa", unknown }, { "ordinate", ordinate } });
+        EXPECT_FALSE(outer.has_value()(0));
+        EXPECT_EQ(outer.value()(1), 2.);
+        EXPECT_EQ(outer.value()(2), 6.);
+        EXPECT_EQ(outer.value()(3), 9.);
+
+        std::vector<int> short_ordinate = { 1, 2 };
+        std::vector<int> int_abscissa = { 0, 1, 2, 0 };
+        EXPECT_THROW(select_many(v, { { "abscissa", abscissa } }), std::invalid_argument);
+        EXPECT_THROW(select_many(v, { { "abscissa", abscissa }, { "ordinate", short_ordinate } }), std::invalid_argument);
+        EXPECT_THROW(select_many(v, { { "abscissa", int_abscissa }, { "ordinate", ordinate } }), std::invalid_argument);
+    }
+
+    TEST(xselect_many, iselect_many)
+    {
+        auto v = make_test_variable();
+        std::vector<std::size_t> abscissa = { 2, 0, 1, 0 };
+        std::vector<std::size_t> ordinate = { 0, 1, 2, 2 };
+
+        auto res = iselect_many(v, { { "abscissa", abscissa }, { "ordinate", ordinate } });
+        ASSERT_EQ(res.size(), 4u);
+        EXPECT_EQ(res.value()(0), 7.);
+        EXPECT_EQ(res.value()(1), 2.);
+        EXPECT_EQ(res.value()(2), 6.);
+        EXPECT_FALSE(res.has_value()(3));
+
+        std::vector<std::size_t> out_of_range = { 0, 3, 0, 0 };
+        EXPECT_THROW(iselect_many(v, { { "abscissa", out_of_range }, { "ordinate", ordinate } }), std::out_of_range);
+    }
+}
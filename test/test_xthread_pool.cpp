@@ -0,0 +1,95 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "gtest/gtest.h"
+#include "xframe/xthread_pool.hpp"
+
+namespace xf
+{
+    TEST(xthread_pool, size)
+    {
+        xthread_pool p1(1);
+        EXPECT_EQ(p1.size(), 1u);
+
+        xthread_pool p4(4);
+        EXPECT_EQ(p4.size(), 4u);
+        p4.resize(2);
+        EXPECT_EQ(p4.size(), 2u);
+
+        xthread_pool p0;
+        EXPECT_GE(p0.size(), 1u);
+    }
+
+    TEST(xthread_pool, parallel_for)
+    {
+        xthread_pool p(4);
+        std::vector<int> res(1000, 0);
+        p.parallel_for(res.size(), [&res](std::size_t i) { res[i] = static_cast<int>(i); });
+        for (std::size_t i = 0; i < res.size(); ++i)
+        {
+            EXPECT_EQ(res[i], static_cast<int>(i));
+        }
+
+        std::atomic<std::size_t> count(0);
+        for (std::size_t k = 0; k < 100; ++k)
+        {
+            p.parallel_for(10, [&count](std::size_t) { ++count; });
+        }
+        EXPECT_EQ(count.load(), 1000u);
+    }
+
+    TEST(xthread_pool, parallel_for_range)
+    {
+        xthread_pool p(3);
+        std::vector<int> res(37, 0);
+        p.parallel_for_range(res.size(), [&res](std::size_t first, std::size_t last)
+        {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                ++res[i];
+            }
+        });
+        for (auto r : res)
+        {
+            EXPECT_EQ(r, 1);
+        }
+    }
+
+    TEST(xthread_pool, nested)
+    {
+        xthread_pool p(4);
+        std::atomic<std::size_t> count(0);
+        p.parallel_for(8, [&p, &count](std::size_t)
+        {
+            p.parallel_for(8, [&count](std::size_t) { ++count; });
+        });
+        EXPECT_EQ(count.load(), 64u);
+    }
+
+    TEST(xthread_pool, exception)
+    {
+        xthread_pool p(4);
+        auto f = [](std::size_t i)
+        {
+            if (i == 5)
+            {
+                throw std::runtime_error("task failed");
+            }
+        };
+        EXPECT_THROW(p.parallel_for(100, f), std::runtime_error);
+
+        std::atomic<std::size_t> count(0);
+        p.parallel_for(10, [&count](std::size_t) { ++count; });
+        EXPECT_EQ(count.load(), 10u);
+    }
+}
@@ -268,6 +268,30 @@ namespace xf
         EXPECT_EQ(t22, v(2, 2));
     }
 
+    TEST(xvariable, compiled_locator)
+    {
+        auto v = make_test_variable();
+        auto loc = compile_locator<fstring, int>(v, "abscissa", "ordinate");
+
+        EXPECT_EQ(loc("a", 1), v(0, 0));
+        EXPECT_EQ(loc("a", 4), v(0, 2));
+        EXPECT_EQ(loc("c", 2), v(1, 1));
+        EXPECT_EQ(loc("d", 1), v(2, 0));
+        EXPECT_EQ(loc("d", 4), v(2, 2));
+        EXPECT_ANY_THROW(loc("b", 1));
+
+        const auto& cv = v;
+        auto rloc = compile_locator<int, fstring>(cv, "ordinate", "abscissa");
+        EXPECT_EQ(rloc(2, "c"), v(1, 1));
+        EXPECT_EQ(rloc(4, "a"), v(0, 2));
+
+        loc("c", 2) = 2.5;
+        EXPECT_EQ(v.locate("c", 2).value(), 2.5);
+
+        EXPECT_ANY_THROW((compile_locator<int, int>(v, "abscissa", "ordinate")));
+        EXPECT_ANY_THROW((compile_locator<fstring, fstring>(v, "abscissa", "abscissa")));
+    }
+
     TEST(xvariable, locate_element)
     {
         auto v = make_test_variable();
@@ -466,5 +466,24 @@ namespace xf
         EXPECT_EQ(res(1, 0), 6.);
         EXPECT_EQ(res(1, 1), 9.);
     }
-}
 
+    TEST(xvariable_assign, broadcast_plan)
+    {
+        variable_type a = make_test_variable();
+        coordinate_type c = make_merge_coordinate();
+        dimension_type dims = {"abscissa", "ordinate", "altitude"};
+        xbroadcast_plan<variable_type> plan(a, c, dims);
+
+        std::vector<std::size_t> idx = {1, 2, 0};
+        EXPECT_EQ(plan.element(idx), a.locate("c", 4));
+
+        idx = {2, 1, 2};
+        EXPECT_EQ(plan.element(idx), a.locate("d", 2));
+
+        idx = {3, 0, 1};
+        EXPECT_FALSE(plan.element(idx).has_value());
+
+        idx = {0, 3, 1};
+        EXPECT_FALSE(plan.element(idx).has_value());
+    }
+}
@@ -0,0 +1,135 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <limits>
+#include "gtest/gtest.h"
+#include "xframe/xvariable_groupby.hpp"
+#include "test_fixture.hpp"
+
+namespace xf
+{
+    //                 ordinate
+    //                1,   2,   4
+    //            a {{1,   2, N/A},
+    // abscissa   c  {N/A, 5,   6},
+    //            d  {7,   8,   9}}
+
+    inline int_variable_type make_test_keys(int_data_type keys)
+    {
+        coordinate_type c = {{ "abscissa", make_test_saxis() }};
+        return int_variable_type(std::move(keys), std::move(c), dimension_type({ "abscissa" }));
+    }
+
+    TEST(xvariable_groupby, groups)
+    {
+        auto v = make_test_variable();
+
+        auto g1 = groupby(v, make_test_keys({ 2, 1, 2 }));
+        EXPECT_EQ(g1.size(), 2u);
+        EXPECT_EQ(g1.keys(), std::vector<int>({ 1, 2 }));
+
+        auto g2 = groupby(v, make_test_keys({ 1, 1, 2 }));
+        EXPECT_EQ(g2.keys(), std::vector<int>({ 1, 2 }));
+
+        int_data_type missing_key = { 3, 0, 3 };
+        missing_key(1).has_value() = false;
+        auto g3 = groupby(v, make_test_keys(missing_key));
+        EXPECT_EQ(g3.keys(), std::vector<int>({ 3 }));
+
+        coordinate_type c = {{ "abscissa", make_test_saxis2() }};
+        int_variable_type other_axis(int_data_type({ 1, 2, 3 }), std::move(c), dimension_type({ "abscissa" }));
+        EXPECT_THROW(groupby(v, other_axis), std::invalid_argument);
+    }
+
+    TEST(xvariable_groupby, sum_count_mean)
+    {
+        auto v = make_test_variable();
+        auto g = groupby(v, make_test_keys({ 2, 1, 2 }));
+
+        auto s = g.sum();
+        EXPECT_EQ(s.dimension_labels()[0], "abscissa");
+        EXPECT_EQ(s.coordinates()["abscissa"].size(), 2u);
+        EXPECT_EQ(s.coordinates()["ordinate"], v.coordinates()["ordinate"]);
+        EXPECT_EQ(s.locate(1, 1).value(), 0.);
+        EXPECT_EQ(s.locate(1, 4).value(), 6.);
+        EXPECT_EQ(s.locate(2, 1).value(), 8.);
+        EXPECT_EQ(s.locate(2, 2).value(), 10.);
+
+        auto c = g.count();
+        EXPECT_EQ(c.locate(1, 1).value(), 0u);
+        EXPECT_EQ(c.locate(2, 1).value(), 2u);
+        EXPECT_EQ(c.locate(2, 4).value(), 1u);
+
+        auto m = g.mean();
+        EXPECT_FALSE(m.locate(1, 1).has_value());
+        EXPECT_EQ(m.locate(1, 2).value(), 5.);
+        EXPECT_EQ(m.locate(2, 1).value(), 4.);
+        EXPECT_EQ(m.locate(2, 4).value(), 9.);
+
+        auto sorted = groupby(v, make_test_keys({ 1, 1, 2 })).sum();
+        EXPECT_EQ(sorted.locate(1, 1).value(), 1.);
+        EXPECT_EQ(sorted.locate(1, 2).value(), 7.);
+        EXPECT_EQ(sorted.locate(2, 4).value(), 9.);
+    }
+
+    TEST(xvariable_groupby, selection)
+    {
+        auto v = make_test_variable();
+        auto g = groupby(v, make_test_keys({ 2, 1, 2 }));
+
+        auto mi = g.amin();
+        EXPECT_FALSE(mi.locate(1, 1).has_value());
+        EXPECT_EQ(mi.locate(2, 1).value(), 1.);
+        EXPECT_EQ(mi.locate(2, 4).value(), 9.);
+
+        auto ma = g.amax();
+        EXPECT_EQ(ma.locate(2, 1).value(), 7.);
+        EXPECT_EQ(ma.locate(2, 2).value(), 8.);
+
+        auto f = g.first();
+        EXPECT_FALSE(f.locate(1, 1).has_value());
+        EXPECT_EQ(f.locate(2, 1).value(), 1.);
+        EXPECT_EQ(f.locate(2, 4).value(), 9.);
+
+        auto l = g.last();
+        EXPECT_EQ(l.locate(2, 1).value(), 7.);
+        EXPECT_EQ(l.locate(2, 4).value(), 9.);
+
+        auto n = g.nunique();
+        EXPECT_EQ(n.locate(1, 1).value(), 0u);
+        EXPECT_EQ(n.locate(2, 1).value(), 2u);
+        EXPECT_EQ(n.locate(2, 4).value(), 1u);
+    }
+
+    TEST(xvariable_groupby, nunique_nan)
+    {
+        auto v = make_test_variable();
+        v.locate("a", 1) = std::numeric_limits<double>::quiet_NaN();
+        v.locate("a", 2) = std::numeric_limits<double>::quiet_NaN();
+        v.locate("d", 2) = std::numeric_limits<double>::quiet_NaN();
+
+        auto n = groupby(v, make_test_keys({ 2, 1, 2 })).nunique();
+        EXPECT_EQ(n.locate(1, 2).value(), 1u);
+        EXPECT_EQ(n.locate(2, 1).value(), 2u);
+        EXPECT_EQ(n.locate(2, 2).value(), 1u);
+        EXPECT_EQ(n.locate(2, 4).value(), 1u);
+    }
+
+    TEST(xvariable_groupby, reduce)
+    {
+        auto v = make_test_variable();
+        auto g = groupby(v, make_test_keys({ 2, 1, 2 }));
+        auto p = g.reduce([](double acc, double x) { return acc * x; }, 1.);
+        EXPECT_FALSE(p.locate(1, 1).has_value());
+        EXPECT_EQ(p.locate(1, 4).value(), 6.);
+        EXPECT_EQ(p.locate(2, 1).value(), 7.);
+        EXPECT_EQ(p.locate(2, 2).value(), 16.);
+    }
+}
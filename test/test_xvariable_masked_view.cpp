@@ -241,4 +241,38 @@ namespace xf
         ASSERT_NE(masked_var.data(), test_var.data());
         ASSERT_NE(var.data(), test_var.data());
     }
+
+    TEST(xvariable_masked_view, separable_mask)
+    {
+        variable_type var = make_test_view_variable();
+        variable_type test_var = make_test_view_variable();
+
+        auto masked_var = where(
+            var,
+            equal(var.axis<fstring>("abscissa"), fstring("c")) &&
+            var.axis<int>("ordinate") > 10
+        );
+        EXPECT_TRUE(masked_var.data().visible().functor().tables().separable());
+        masked_var = 1.5;
+        EXPECT_EQ(var.select({{"abscissa", "c"}, {"ordinate", 12}}), 1.5);
+        EXPECT_EQ(var.select({{"abscissa", "c"}, {"ordinate", 13}}), 1.5);
+        EXPECT_EQ(var.select({{"abscissa", "c"}, {"ordinate", 8}}), 13.);
+        EXPECT_EQ(var.select({{"abscissa", "a"}, {"ordinate", 12}}), 6.);
+
+        auto masked_var2 = where(
+            var,
+            var.axis<int>("ordinate") < 2 || equal(var.axis<fstring>("abscissa"), fstring("n"))
+        );
+        EXPECT_FALSE(masked_var2.data().visible().functor().tables().separable());
+        masked_var2 = -1.;
+        EXPECT_EQ(var.select({{"abscissa", "a"}, {"ordinate", 1}}), -1.);
+        EXPECT_EQ(var.select({{"abscissa", "n"}, {"ordinate", 13}}), -1.);
+        EXPECT_EQ(var.select({{"abscissa", "a"}, {"ordinate", 13}}), 7.);
+
+        variable_type var2 = make_test_view_variable();
+        auto masked_var3 = where(var2, var2.axis<int>("ordinate") > 100);
+        EXPECT_TRUE(masked_var3.data().visible().functor().tables().separable());
+        masked_var3 = 0.;
+        EXPECT_EQ(var2.data(), test_var.data());
+    }
 }
@@ -0,0 +1,110 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <cmath>
+#include "gtest/gtest.h"
+#include "xframe/xvariable_reducer.hpp"
+#include "test_fixture.hpp"
+
+namespace xf
+{
+    //                 ordinate
+    //                1,   2,   4
+    //            a {{1,   2, N/A},
+    // abscissa   c  {N/A, 5,   6},
+    //            d  {7,   8,   9}}
+
+    TEST(xvariable_reducer, sum)
+    {
+        auto v = make_test_variable();
+
+        auto s1 = xf::sum(v, { "ordinate" });
+        EXPECT_EQ(s1.dimension(), 1u);
+        EXPECT_EQ(s1.dimension_labels()[0], "abscissa");
+        EXPECT_EQ(s1.coordinates()["abscissa"], v.coordinates()["abscissa"]);
+        EXPECT_EQ(s1.locate("a").value(), 3.);
+        EXPECT_EQ(s1.locate("c").value(), 11.);
+        EXPECT_EQ(s1.locate("d").value(), 24.);
+
+        auto s2 = xf::sum(v, { "abscissa" });
+        EXPECT_EQ(s2.dimension_labels()[0], "ordinate");
+        EXPECT_EQ(s2.locate(1).value(), 8.);
+        EXPECT_EQ(s2.locate(2).value(), 15.);
+        EXPECT_EQ(s2.locate(4).value(), 15.);
+
+        auto s3 = xf::sum(v, {});
+        EXPECT_EQ(s3.dimension(), 2u);
+        EXPECT_EQ(s3.locate("c", 2).value(), 5.);
+        EXPECT_EQ(s3.locate("c", 1).value(), 0.);
+
+        EXPECT_ANY_THROW(xf::sum(v, { "altitude" }));
+    }
+
+    TEST(xvariable_reducer, count)
+    {
+        auto v = make_test_variable();
+        auto c = xf::count(v, { "ordinate" });
+        EXPECT_EQ(c.locate("a").value(), 2u);
+        EXPECT_EQ(c.locate("c").value(), 2u);
+        EXPECT_EQ(c.locate("d").value(), 3u);
+    }
+
+    TEST(xvariable_reducer, mean)
+    {
+        auto v = make_test_variable();
+        auto m1 = xf::mean(v, { "ordinate" });
+        EXPECT_EQ(m1.locate("a").value(), 1.5);
+        EXPECT_EQ(m1.locate("c").value(), 5.5);
+        EXPECT_EQ(m1.locate("d").value(), 8.);
+
+        v.locate("a", 1).has_value() = false;
+        v.locate("d", 1).has_value() = false;
+        auto m2 = xf::mean(v, { "abscissa" });
+        EXPECT_FALSE(m2.locate(1).has_value());
+        EXPECT_EQ(m2.locate(2).value(), 5.);
+        EXPECT_EQ(m2.locate(4).value(), 7.5);
+    }
+
+    TEST(xvariable_reducer, amin_amax)
+    {
+        auto v = make_test_variable();
+        auto mi = xf::amin(v, { "abscissa" });
+        EXPECT_EQ(mi.locate(1).value(), 1.);
+        EXPECT_EQ(mi.locate(2).value(), 2.);
+        EXPECT_EQ(mi.locate(4).value(), 6.);
+
+        auto ma = xf::amax(v, { "ordinate" });
+        EXPECT_EQ(ma.locate("a").value(), 2.);
+        EXPECT_EQ(ma.locate("c").value(), 6.);
+        EXPECT_EQ(ma.locate("d").value(), 9.);
+
+        v.locate("a", 1).has_value() = false;
+        v.locate("d", 1).has_value() = false;
+        auto mi2 = xf::amin(v, { "abscissa" });
+        EXPECT_FALSE(mi2.locate(1).has_value());
+    }
+
+    TEST(xvariable_reducer, variance)
+    {
+        auto v = make_test_variable();
+        auto var = xf::variance(v, { "ordinate" });
+        EXPECT_DOUBLE_EQ(var.locate("a").value(), 0.25);
+        EXPECT_DOUBLE_EQ(var.locate("c").value(), 0.25);
+        EXPECT_DOUBLE_EQ(var.locate("d").value(), 2. / 3.);
+
+        auto sd = xf::stddev(v, { "ordinate" }, 1);
+        EXPECT_DOUBLE_EQ(sd.locate("a").value(), std::sqrt(0.5));
+        EXPECT_DOUBLE_EQ(sd.locate("d").value(), 1.);
+
+        auto sd2 = xf::stddev(v, { "ordinate" }, 2);
+        EXPECT_FALSE(sd2.locate("a").has_value());
+        EXPECT_TRUE(sd2.locate("d").has_value());
+    }
+}
@@ -478,6 +478,80 @@ namespace xf
         EXPECT_EQ(vii2, v2);
     }
 
+    TEST(xvariable_view, view_squeeze_inner)
+    {
+        variable_type var = make_test_view_variable();
+        variable_view_type view = select(var, { { "abscissa", range("c", "g") }, { "ordinate", 8 } });
+        EXPECT_EQ(view.size(), 4u);
+        EXPECT_EQ(view.dimension(), 1u);
+        saxis_type s = { "abscissa" };
+        EXPECT_EQ(view.dimension_labels(), s.labels());
+
+        auto v0 = var.select({ { "abscissa", "c" },{ "ordinate", 8 } });
+        auto v1 = var.select({ { "abscissa", "d" },{ "ordinate", 8 } });
+        auto v3 = var.select({ { "abscissa", "g" },{ "ordinate", 8 } });
+
+        EXPECT_EQ(view(0), v0);
+        EXPECT_EQ(view(1), v1);
+        EXPECT_EQ(view(3), v3);
+
+        EXPECT_EQ(view.element({ 0 }), v0);
+        EXPECT_EQ(view.element({ 1 }), v1);
+        EXPECT_EQ(view.element({ 3 }), v3);
+
+        EXPECT_EQ(view.locate("c"), v0);
+        EXPECT_EQ(view.locate("d"), v1);
+        EXPECT_EQ(view.locate("g"), v3);
+
+        EXPECT_EQ(view.locate_element({ "c" }), v0);
+        EXPECT_EQ(view.locate_element({ "g" }), v3);
+
+        EXPECT_EQ(view.select({ { "abscissa", "d" } }), v1);
+        EXPECT_EQ(view.iselect({ { "abscissa", 3 } }), v3);
+
+        const variable_view_type& cview = view;
+        EXPECT_EQ(cview(1), v1);
+        EXPECT_EQ(cview.element({ 3 }), v3);
+        EXPECT_EQ(cview.locate("d"), v1);
+        EXPECT_EQ(cview.locate_element({ "c" }), v0);
+    }
+
+    TEST(xvariable_view, strided_assign)
+    {
+        variable_type var = make_test_view_variable();
+        variable_type src = make_test_view_variable();
+
+        {
+            SCOPED_TRACE("range and all slices");
+            variable_view_type view = locate(var, range("c", "g"), all());
+            variable_view_type src_view = locate(src, range("c", "g"), all());
+            view = 2. * src_view;
+            EXPECT_EQ(var.locate("a", 1).value(), 0.);
+            EXPECT_EQ(var.locate("c", 1).value(), 16.);
+            EXPECT_EQ(var.locate("g", 13).value(), 78.);
+            EXPECT_EQ(var.locate("h", 1).value(), 40.);
+            EXPECT_FALSE(var.locate("d", 5).has_value());
+        }
+
+        {
+            SCOPED_TRACE("squeezed scalar");
+            variable_view_type view = locate(var, "h", all());
+            view = 1.;
+            EXPECT_EQ(var.locate("h", 1).value(), 1.);
+            EXPECT_EQ(var.locate("h", 13).value(), 1.);
+            EXPECT_EQ(var.locate("g", 13).value(), 78.);
+        }
+
+        {
+            SCOPED_TRACE("keep slice");
+            variable_view_type view = locate(var, xf::keep("a", "n"), range(1, 2));
+            view = 100.;
+            EXPECT_EQ(var.locate("a", 1).value(), 100.);
+            EXPECT_EQ(var.locate("n", 2).value(), 100.);
+            EXPECT_EQ(var.locate("c", 1).value(), 16.);
+        }
+    }
+
     TEST(xvariable_view, locate_builder)
     {
         variable_type var = make_test_view_variable();
@@ -560,4 +634,27 @@ namespace xf
         EXPECT_EQ(view, view4);
         EXPECT_EQ(view, view5);
     }
+
+    TEST(xvariable_view, positions)
+    {
+        variable_type var = make_test_view_variable();
+        auto check = [](const auto& view)
+        {
+            const auto& shape = view.data().shape();
+            for (std::size_t i = 0; i < shape[0]; ++i)
+            {
+                for (std::size_t j = 0; j < shape[1]; ++j)
+                {
+                    EXPECT_EQ(view(i, j).has_value(), view.data()(i, j).has_value());
+                    EXPECT_EQ(view(i, j).value(), view.data()(i, j).value());
+                    EXPECT_EQ(view.element({ i, j }).value(), view.data()(i, j).value());
+                }
+            }
+        };
+
+        check(ilocate(var, irange(1, 7, 2), iall()));
+        check(ilocate(var, ikeep(6, 1, 3), irange(0, 5, 2)));
+        check(locate(var, range("c", "m"), xf::drop(1, 5)));
+        check(select(var, { { "abscissa", range("d", "n", 3) } }));
+    }
 }
@@ -0,0 +1,195 @@
+/***************************************************************************
+* Copyright (c) Johan Mabille, Sylvain Corlay, Wolf Vollprecht and         *
+* Martin Renou                                                             *
+* Copyright (c) QuantStack                                                 *
+*                                                                          *
+* Distributed under the terms of the BSD 3-Clause License.                 *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <cmath>
+#include <limits>
+#include "gtest/gtest.h"
+#include "xframe/xvariable_window.hpp"
+#include "test_fixture.hpp"
+
+namespace xf
+{
+    //                 ordinate
+    //                1,   2,   4
+    //            a {{1,   2, N/A},
+    // abscissa   c  {N/A, 5,   6},
+    //            d  {7,   8,   9}}
+
+    TEST(xvariable_window, rolling_sum)
+    {
+        auto v = make_test_variable();
+
+        auto s1 = rolling(v, "abscissa", 2).sum();
+        EXPECT_EQ(s1.coordinates(), v.coordinates());
+        EXPECT_EQ(s1.dimension_labels(), v.dimension_labels());
+        EXPECT_EQ(s1.locate("a", 1).value(), 1.);
+        EXPECT_FALSE(s1.locate("a", 4).has_value());
+        EXPECT_EQ(s1.locate("c", 2).value(), 7.);
+        EXPECT_EQ(s1.locate("d", 1).value(), 7.);
+        EXPECT_EQ(s1.locate("d", 4).value(), 15.);
+
+        auto s2 = rolling(v, "abscissa", 2, 2).sum();
+        EXPECT_FALSE(s2.locate("c", 1).has_value());
+        EXPECT_EQ(s2.locate("c", 2).value(), 7.);
+
+        auto s3 = rolling(v, "ordinate", 2).sum();
+        EXPECT_EQ(s3.locate("a", 4).value(), 2.);
+        EXPECT_FALSE(s3.locate("c", 1).has_value());
+        EXPECT_EQ(s3.locate("c", 4).value(), 11.);
+
+        auto c = rolling(v, "abscissa", 2).count();
+        EXPECT_EQ(c.locate("c", 1).value(), 1u);
+        EXPECT_EQ(c.locate("d", 2).value(), 2u);
+
+        EXPECT_THROW(rolling(v, "abscissa", 0), std::invalid_argument);
+    }
+
+    TEST(xvariable_window, rolling_sum_large_value)
+    {
+        auto v = make_test_variable();
+        v.locate("a", 2) = 1e20;
+
+        auto s = rolling(v, "abscissa", 2).sum();
+        EXPECT_EQ(s.locate("c", 2).value(), 1e20);
+        EXPECT_EQ(s.locate("d", 2).value(), 13.);
+        EXPECT_EQ(s.locate("d", 1).value(), 7.);
+    }
+
+    TEST(xvariable_window, rolling_sum_inf)
+    {
+        auto v = make_test_variable();
+        v.locate("a", 2) = std::numeric_limits<double>::infinity();
+
+        auto s = rolling(v, "abscissa", 2).sum();
+        EXPECT_EQ(s.locate("a", 2).value(), std::numeric_limits<double>::infinity());
+        EXPECT_EQ(s.locate("c", 2).value(), std::numeric_limits<double>::infinity());
+        EXPECT_EQ(s.locate("d", 2).value(), 13.);
+
+        v.locate("c", 2) = -std::numeric_limits<double>::infinity();
+        auto s2 = rolling(v, "abscissa", 2).sum();
+        EXPECT_TRUE(std::isnan(s2.locate("c", 2).value()));
+        EXPECT_EQ(s2.locate("d", 2).value(), -std::numeric_limits<double>::infinity());
+    }
+
+    TEST(xvariable_window, rolling_moments)
+    {
+        auto v = make_test_variable();
+        auto w = rolling(v, "abscissa", 2);
+
+        auto m = w.mean();
+        EXPECT_EQ(m.locate("d", 1).value(), 7.);
+        EXPECT_EQ(m.locate("d", 2).value(), 6.5);
+        EXPECT_EQ(m.locate("d", 4).value(), 7.5);
+
+        auto var = w.variance();
+        EXPECT_DOUBLE_EQ(var.locate("d", 1).value(), 0.);
+        EXPECT_DOUBLE_EQ(var.locate("d", 2).value(), 2.25);
+
+        auto sd = w.stddev(1);
+        EXPECT_FALSE(sd.locate("d", 1).has_value());
+        EXPECT_DOUBLE_EQ(sd.locate("d", 4).value(), std::sqrt(4.5));
+    }
+
+    TEST(xvariable_window, rolling_moments_large_value)
+    {
+        auto v = make_test_variable();
+        v.locate("a", 2) = 1e20;
+        auto w = rolling(v, "abscissa", 2);
+
+        auto m = w.mean();
+        EXPECT_DOUBLE_EQ(m.locate("c", 2).value(), 5e19);
+        EXPECT_EQ(m.locate("d", 2).value(), 6.5);
+
+        auto var = w.variance();
+        EXPECT_EQ(var.locate("d", 2).value(), 2.25);
+        EXPECT_EQ(var.locate("d", 1).value(), 0.);
+    }
+
+    TEST(xvariable_window, rolling_moments_inf)
+    {
+        auto v = make_test_variable();
+        v.locate("a", 2) = std::numeric_limits<double>::infinity();
+        auto w = rolling(v, "abscissa", 2);
+
+        auto m = w.mean();
+        EXPECT_EQ(m.locate("a", 2).value(), std::numeric_limits<double>::infinity());
+        EXPECT_EQ(m.locate("c", 2).value(), std::numeric_limits<double>::infinity());
+        EXPECT_EQ(m.locate("d", 2).value(), 6.5);
+
+        auto var = w.variance();
+        EXPECT_TRUE(std::isnan(var.locate("c", 2).value()));
+        EXPECT_EQ(var.locate("d", 2).value(), 2.25);
+
+        v.locate("c", 2) = -std::numeric_limits<double>::infinity();
+        auto m2 = rolling(v, "abscissa", 2).mean();
+        EXPECT_TRUE(std::isnan(m2.locate("c", 2).value()));
+        EXPECT_EQ(m2.locate("d", 2).value(), -std::numeric_limits<double>::infinity());
+    }
+
+    TEST(xvariable_window, rolling_moments_nan)
+    {
+        auto v = make_test_variable();
+        v.locate("a", 2) = std::numeric_limits<double>::quiet_NaN();
+        auto w = rolling(v, "abscissa", 2);
+
+        auto m = w.mean();
+        EXPECT_TRUE(std::isnan(m.locate("c", 2).value()));
+        EXPECT_EQ(m.locate("d", 2).value(), 6.5);
+
+        auto sd = w.stddev();
+        EXPECT_TRUE(std::isnan(sd.locate("c", 2).value()));
+        EXPECT_EQ(sd.locate("d", 2).value(), 1.5);
+    }
+
+    TEST(xvariable_window, rolling_extremum)
+    {
+        auto v = make_test_variable();
+        auto w = rolling(v, "abscissa", 2);
+
+        auto mi = w.amin();
+        EXPECT_EQ(mi.locate("c", 1).value(), 1.);
+        EXPECT_EQ(mi.locate("d", 1).value(), 7.);
+        EXPECT_EQ(mi.locate("d", 2).value(), 5.);
+        EXPECT_FALSE(mi.locate("a", 4).has_value());
+
+        auto ma = w.amax();
+        EXPECT_EQ(ma.locate("c", 2).value(), 5.);
+        EXPECT_EQ(ma.locate("d", 4).value(), 9.);
+    }
+
+    TEST(xvariable_window, rolling_span)
+    {
+        auto v = make_test_variable();
+        auto s = rolling_span(v, "ordinate", 2).sum();
+        EXPECT_EQ(s.locate("d", 1).value(), 7.);
+        EXPECT_EQ(s.locate("d", 2).value(), 15.);
+        EXPECT_EQ(s.locate("d", 4).value(), 9.);
+
+        EXPECT_THROW(rolling_span(v, "abscissa", 2), std::invalid_argument);
+    }
+
+    TEST(xvariable_window, expanding)
+    {
+        auto v = make_test_variable();
+        auto w = expanding(v, "abscissa");
+
+        auto s = w.sum();
+        EXPECT_EQ(s.locate("d", 1).value(), 8.);
+        EXPECT_EQ(s.locate("d", 2).value(), 15.);
+        EXPECT_EQ(s.locate("d", 4).value(), 15.);
+
+        auto var = w.variance();
+        EXPECT_DOUBLE_EQ(var.locate("d", 2).value(), 6.);
+
+        auto mi = w.amin();
+        EXPECT_EQ(mi.locate("d", 1).value(), 1.);
+        EXPECT_EQ(mi.locate("d", 4).value(), 6.);
+    }
+}